@@ -0,0 +1,54 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../../src/address/SocketAddress.h"
+
+namespace
+{
+    const int ITERATIONS = 100000;
+    const int UNCACHED_ITERATIONS = 10000;
+
+    /**
+     * Resolves the hostname the given amount of times and prints the average time of a single lookup in nanoseconds.
+     */
+    template <typename Resolve>
+    double measure(const char* name, const std::string& hostname, const int& iterations, Resolve resolve)
+    {
+        addrinfo hints = kt::createTcpHints();
+        size_t resolved = 0;
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            resolved += resolve(hostname, static_cast<unsigned short>(80), hints).first.size();
+        }
+        const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+        const double perLookup = static_cast<double>(elapsed.count()) / iterations;
+        std::printf("%-28s %-10s %12.1f ns/lookup (%zu addresses)\n", name, hostname.c_str(), perLookup, resolved);
+        return perLookup;
+    }
+}
+
+/**
+ * Compares resolving IP literals through *kt::resolveToAddresses()*, which parses them directly, against
+ * *kt::resolveToAddressesUncached()*, which always goes through *getaddrinfo()*.
+ */
+int main()
+{
+    for (const std::string hostname : { "10.0.3.7", "::1" })
+    {
+        const double parsed = measure("resolveToAddresses", hostname, ITERATIONS, [](const std::string& host, const unsigned short& port, addrinfo& hints)
+        {
+            return kt::resolveToAddresses(host, port, hints);
+        });
+        const double uncached = measure("resolveToAddressesUncached", hostname, UNCACHED_ITERATIONS, [](const std::string& host, const unsigned short& port, addrinfo& hints)
+        {
+            return kt::resolveToAddressesUncached(host, port, hints);
+        });
+        std::printf("%-28s %-10s %12.1fx\n", "speedup", hostname.c_str(), uncached / parsed);
+    }
+    return 0;
+}
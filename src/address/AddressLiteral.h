@@ -0,0 +1,223 @@
+#pragma once
+
+#include "SocketAddress.h"
+#include "../enums/InternetProtocolVersion.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+namespace kt
+{
+    namespace detail
+    {
+        constexpr int hexValue(const char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                return c - 'A' + 10;
+            }
+            return -1;
+        }
+    }
+
+    /**
+     * Parses a dotted-decimal IPv4 address such as "10.0.3.7". Accepts the same strict form as *inet_pton()*, so shorthand forms like
+     * "10.1" or octets with leading zeros are rejected.
+     *
+     * @return the address in network byte order, or *std::nullopt* if the text is not an IPv4 literal.
+     */
+    constexpr std::optional<std::array<uint8_t, 4>> parseIPv4Literal(const std::string_view text)
+    {
+        std::array<uint8_t, 4> bytes{};
+        size_t part = 0;
+        unsigned int value = 0;
+        size_t digits = 0;
+        for (size_t i = 0; i <= text.size(); i++)
+        {
+            if (i == text.size() || text[i] == '.')
+            {
+                if (digits == 0 || part == bytes.size())
+                {
+                    return std::nullopt;
+                }
+                bytes[part++] = static_cast<uint8_t>(value);
+                value = 0;
+                digits = 0;
+                continue;
+            }
+
+            const char c = text[i];
+            if (c < '0' || c > '9' || (digits == 1 && value == 0))
+            {
+                return std::nullopt;
+            }
+            value = (value * 10) + static_cast<unsigned int>(c - '0');
+            if (value > 255)
+            {
+                return std::nullopt;
+            }
+            digits++;
+        }
+
+        if (part != bytes.size())
+        {
+            return std::nullopt;
+        }
+        return bytes;
+    }
+
+    /**
+     * Parses an IPv6 address such as "::1" or "2001:db8::7", including a trailing embedded IPv4 address such as "::ffff:10.0.3.7".
+     * Addresses with a zone index ("fe80::1%eth0") are not literals for this purpose and are rejected.
+     *
+     * @return the address in network byte order, or *std::nullopt* if the text is not an IPv6 literal.
+     */
+    constexpr std::optional<std::array<uint8_t, 16>> parseIPv6Literal(const std::string_view text)
+    {
+        std::array<uint8_t, 16> bytes{};
+        size_t length = 0;
+        // Where the "::" was found, if at all, as an offset into bytes
+        size_t gap = bytes.size() + 1;
+        size_t i = 0;
+
+        if (text.size() < 2)
+        {
+            return std::nullopt;
+        }
+        if (text[0] == ':')
+        {
+            if (text[1] != ':')
+            {
+                return std::nullopt;
+            }
+            gap = 0;
+            i = 2;
+        }
+
+        while (i < text.size())
+        {
+            const size_t start = i;
+            unsigned int value = 0;
+            size_t digits = 0;
+            while (i < text.size() && detail::hexValue(text[i]) >= 0)
+            {
+                if (++digits > 4)
+                {
+                    return std::nullopt;
+                }
+                value = (value * 16) + static_cast<unsigned int>(detail::hexValue(text[i]));
+                i++;
+            }
+
+            if (i < text.size() && text[i] == '.')
+            {
+                const std::optional<std::array<uint8_t, 4>> ipv4 = parseIPv4Literal(text.substr(start));
+                if (!ipv4.has_value() || length > bytes.size() - 4)
+                {
+                    return std::nullopt;
+                }
+                for (const uint8_t byte : ipv4.value())
+                {
+                    bytes[length++] = byte;
+                }
+                break;
+            }
+
+            if (digits == 0 || length > bytes.size() - 2)
+            {
+                return std::nullopt;
+            }
+            bytes[length++] = static_cast<uint8_t>(value >> 8);
+            bytes[length++] = static_cast<uint8_t>(value & 0xFF);
+
+            if (i == text.size())
+            {
+                break;
+            }
+            if (text[i] != ':' || ++i == text.size())
+            {
+                return std::nullopt;
+            }
+            if (text[i] == ':')
+            {
+                if (gap <= bytes.size())
+                {
+                    return std::nullopt;
+                }
+                gap = length;
+                i++;
+            }
+        }
+
+        if (gap > bytes.size())
+        {
+            return length == bytes.size() ? std::optional<std::array<uint8_t, 16>>{bytes} : std::nullopt;
+        }
+        // "::" has to stand for at least one group of zeros
+        if (length == bytes.size())
+        {
+            return std::nullopt;
+        }
+
+        // Move the groups after the "::" to the end and zero fill the gap
+        const size_t tail = length - gap;
+        for (size_t k = 0; k < tail; k++)
+        {
+            bytes[bytes.size() - 1 - k] = bytes[length - 1 - k];
+        }
+        for (size_t k = gap; k < bytes.size() - tail; k++)
+        {
+            bytes[k] = 0;
+        }
+        return bytes;
+    }
+
+    /**
+     * Builds a *kt::SocketAddress* from an IP literal without calling the resolver or allocating.
+     *
+     * @param text - The IPv4 or IPv6 literal.
+     * @param port - The port to set on the address.
+     * @param protocolVersion - Restricts which kind of literal is accepted, *Any* accepts both.
+     *
+     * @return the address, or *std::nullopt* if the text is not a literal of an accepted version and has to be resolved instead.
+     */
+    inline std::optional<kt::SocketAddress> parseAddressLiteral(const std::string_view text, const unsigned short& port, const kt::InternetProtocolVersion protocolVersion = kt::InternetProtocolVersion::Any)
+    {
+        kt::SocketAddress address{};
+        if (protocolVersion != kt::InternetProtocolVersion::IPV6)
+        {
+            const std::optional<std::array<uint8_t, 4>> ipv4 = parseIPv4Literal(text);
+            if (ipv4.has_value())
+            {
+                address.ipv4.sin_family = AF_INET;
+                address.ipv4.sin_port = htons(port);
+                std::memcpy(&address.ipv4.sin_addr, ipv4.value().data(), ipv4.value().size());
+                return address;
+            }
+        }
+
+        if (protocolVersion != kt::InternetProtocolVersion::IPV4)
+        {
+            const std::optional<std::array<uint8_t, 16>> ipv6 = parseIPv6Literal(text);
+            if (ipv6.has_value())
+            {
+                address.ipv6.sin6_family = AF_INET6;
+                address.ipv6.sin6_port = htons(port);
+                std::memcpy(&address.ipv6.sin6_addr, ipv6.value().data(), ipv6.value().size());
+                return address;
+            }
+        }
+        return std::nullopt;
+    }
+}
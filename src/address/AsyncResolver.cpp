@@ -0,0 +1,149 @@
+#include "AsyncResolver.h"
+#include "ResolverCache.h"
+
+namespace kt
+{
+    /**
+     * AsyncResolver constructor. Starts the resolver threads immediately.
+     *
+     * @param threadCount - The amount of lookups that can run at the same time, 0 is treated as 1.
+     */
+    AsyncResolver::AsyncResolver(const unsigned int& threadCount)
+    {
+        const unsigned int count = threadCount == 0 ? 1 : threadCount;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            this->threads.emplace_back(&AsyncResolver::work, this);
+        }
+    }
+
+    /**
+     * Finishes every lookup that has already been requested, then stops the resolver threads.
+     */
+    AsyncResolver::~AsyncResolver()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->running = false;
+        }
+        this->queued.notify_all();
+        for (std::thread& thread : this->threads)
+        {
+            thread.join();
+        }
+    }
+
+    /**
+     * Returns the pending request for the lookup, queueing a new one if there is none. Must be called with the mutex held.
+     */
+    AsyncResolver::Request& AsyncResolver::enqueue(const std::string& hostname, const unsigned short& port, const addrinfo& hints)
+    {
+        const std::string key = kt::detail::makeResolveKey(hostname, port, hints);
+
+        auto existing = this->pending.find(key);
+        if (existing != this->pending.end())
+        {
+            this->coalesced++;
+            return existing->second;
+        }
+
+        Request& request = this->pending[key];
+        request.hostname = hostname;
+        request.port = port;
+        request.hints = hints;
+        request.future = request.promise.get_future().share();
+        this->queue.push_back(key);
+        this->queued.notify_one();
+        return request;
+    }
+
+    void AsyncResolver::work()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (true)
+        {
+            this->queued.wait(lock, [this]() { return !this->queue.empty() || !this->running; });
+            if (this->queue.empty())
+            {
+                return;
+            }
+
+            const std::string key = this->queue.front();
+            this->queue.pop_front();
+            // The request stays pending while it is resolved so lookups requested meanwhile are coalesced into it
+            Request& request = this->pending.at(key);
+            const std::string hostname = request.hostname;
+            const unsigned short port = request.port;
+            addrinfo hints = request.hints;
+
+            lock.unlock();
+            std::pair<std::vector<kt::SocketAddress>, int> resolved = kt::resolveToAddresses(hostname, port, hints);
+            this->lookups++;
+            lock.lock();
+
+            Request completed = std::move(this->pending.at(key));
+            this->pending.erase(key);
+
+            lock.unlock();
+            completed.promise.set_value(resolved);
+            for (const Callback& callback : completed.callbacks)
+            {
+                try
+                {
+                    callback(resolved);
+                }
+                catch (...)
+                {
+                    // A failing callback must not stop the resolver thread or the remaining callbacks
+                }
+            }
+            lock.lock();
+        }
+    }
+
+    /**
+     * Queues a lookup, or joins the pending lookup for the same hostname, port and hints.
+     *
+     * @return a future holding the result of *kt::resolveToAddresses()* for the lookup.
+     */
+    std::shared_future<std::pair<std::vector<kt::SocketAddress>, int>> AsyncResolver::resolve(const std::string& hostname, const unsigned short& port, const addrinfo& hints)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->enqueue(hostname, port, hints).future;
+    }
+
+    /**
+     * Queues a lookup, or joins the pending lookup for the same hostname, port and hints, and calls the callback with its result.
+     * The callback is run on a resolver thread, so it should hand the result to the thread that needs it rather than do slow work.
+     */
+    void AsyncResolver::resolve(const std::string& hostname, const unsigned short& port, const addrinfo& hints, const Callback& callback)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->enqueue(hostname, port, hints).callbacks.push_back(callback);
+    }
+
+    /**
+     * @return the amount of distinct lookups that are queued or running.
+     */
+    size_t AsyncResolver::getPendingCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->pending.size();
+    }
+
+    /**
+     * @return the amount of lookups that were performed.
+     */
+    size_t AsyncResolver::getLookupCount() const
+    {
+        return this->lookups;
+    }
+
+    /**
+     * @return the amount of requests that shared a lookup that was already pending.
+     */
+    size_t AsyncResolver::getCoalescedCount() const
+    {
+        return this->coalesced;
+    }
+}
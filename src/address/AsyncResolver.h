@@ -0,0 +1,71 @@
+#pragma once
+
+#include "SocketAddress.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace kt
+{
+    /**
+     * Resolves hostnames on a small pool of threads, so a slow resolver does not block the thread running an event loop.
+     *
+     * Lookups for the same hostname, port and hints that are requested while one is already pending share that lookup instead of
+     * queueing another. Lookups go through *kt::resolveToAddresses()*, so an installed *kt::ResolverCache* is used as well.
+     *
+     * The resolved addresses can be passed directly to *kt::TCPSocket(const kt::SocketAddress)* or *kt::UDPSocket::sendTo()*.
+     * All methods may be called from any thread.
+     */
+    class AsyncResolver
+    {
+        public:
+            typedef std::function<void(const std::pair<std::vector<kt::SocketAddress>, int>&)> Callback;
+
+        private:
+            struct Request
+            {
+                std::string hostname;
+                unsigned short port = 0;
+                addrinfo hints{};
+                std::promise<std::pair<std::vector<kt::SocketAddress>, int>> promise;
+                std::shared_future<std::pair<std::vector<kt::SocketAddress>, int>> future;
+                std::vector<Callback> callbacks;
+            };
+
+            std::mutex mutex;
+            std::condition_variable queued;
+            std::unordered_map<std::string, Request> pending;
+            std::deque<std::string> queue;
+            std::vector<std::thread> threads;
+            bool running = true;
+
+            std::atomic<size_t> lookups{0};
+            std::atomic<size_t> coalesced{0};
+
+            Request& enqueue(const std::string&, const unsigned short&, const addrinfo&);
+            void work();
+
+        public:
+            AsyncResolver(const unsigned int& = 2);
+            ~AsyncResolver();
+
+            AsyncResolver(const kt::AsyncResolver&) = delete;
+            kt::AsyncResolver& operator=(const kt::AsyncResolver&) = delete;
+
+            std::shared_future<std::pair<std::vector<kt::SocketAddress>, int>> resolve(const std::string&, const unsigned short&, const addrinfo&);
+            void resolve(const std::string&, const unsigned short&, const addrinfo&, const Callback&);
+
+            size_t getPendingCount();
+            size_t getLookupCount() const;
+            size_t getCoalescedCount() const;
+    };
+}
@@ -0,0 +1,307 @@
+#include "ResolverCache.h"
+
+#include <functional>
+#include <tuple>
+
+namespace kt
+{
+    namespace
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        std::atomic<std::shared_ptr<kt::ResolverCache>> installedCache;
+#else
+        // The std::atomic_load() and std::atomic_store() overloads for std::shared_ptr are deprecated from C++20, so standard
+        // libraries without std::atomic<std::shared_ptr> guard the pointer with a mutex instead
+        std::mutex installedCacheMutex;
+        std::shared_ptr<kt::ResolverCache> installedCache;
+#endif
+    }
+
+    /**
+     * ResolverCache constructor.
+     *
+     * @param timeToLive - The amount of microseconds a successful lookup is reused for, 0 disables caching successful lookups.
+     * @param negativeTimeToLive - The amount of microseconds a lookup for a name that does not exist is reused for, 0 disables negative caching.
+     * @param stripeCount - The amount of independently locked partitions of the cache, 0 is treated as 1.
+     */
+    ResolverCache::ResolverCache(const long& timeToLive, const long& negativeTimeToLive, const unsigned int& stripeCount)
+        : timeToLive(timeToLive), negativeTimeToLive(negativeTimeToLive)
+    {
+        const unsigned int count = stripeCount == 0 ? 1 : stripeCount;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            this->stripes.push_back(std::make_unique<Stripe>());
+        }
+    }
+
+    ResolverCache::~ResolverCache()
+    {
+        this->stopRefreshing();
+    }
+
+    /**
+     * Builds the key identifying a lookup, made up of the hostname, port and every field of the hints that changes the answer.
+     * Shared by the cache and *kt::AsyncResolver* so both consider the same lookups equal.
+     */
+    std::string detail::makeResolveKey(const std::string& hostname, const unsigned short& port, const addrinfo& hints)
+    {
+        return hostname + '|' + std::to_string(port) + '|' + std::to_string(hints.ai_family) + '|' + std::to_string(hints.ai_socktype)
+            + '|' + std::to_string(hints.ai_protocol) + '|' + std::to_string(hints.ai_flags);
+    }
+
+    ResolverCache::Stripe& ResolverCache::getStripe(const std::string& key) const
+    {
+        return *this->stripes[std::hash<std::string>{}(key) % this->stripes.size()];
+    }
+
+    /**
+     * Only answers that will not change by simply asking again are cached, anything else is retried by the next lookup.
+     */
+    bool ResolverCache::isCacheable(const int& result) const
+    {
+        if (result == 0)
+        {
+            return this->timeToLive.count() > 0;
+        }
+
+#ifdef EAI_NODATA
+        const bool doesNotExist = result == EAI_NONAME || result == EAI_FAIL || result == EAI_NODATA;
+#else
+        const bool doesNotExist = result == EAI_NONAME || result == EAI_FAIL;
+#endif
+        return doesNotExist && this->negativeTimeToLive.count() > 0;
+    }
+
+    /**
+     * Resolves the name without the lock held and replaces the cached entry with the result. Refreshes do not count as a use, so an
+     * entry nobody looks up is only refreshed once.
+     */
+    std::pair<std::vector<kt::SocketAddress>, int> ResolverCache::store(const std::string& key, const std::string& hostname, const unsigned short& port, const addrinfo& hints, const bool& used)
+    {
+        std::pair<std::vector<kt::SocketAddress>, int> resolved = kt::resolveToAddressesUncached(hostname, port, hints);
+
+        Stripe& stripe = this->getStripe(key);
+        std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+        if (!this->isCacheable(resolved.second))
+        {
+            stripe.entries.erase(key);
+            return resolved;
+        }
+
+        Entry& entry = stripe.entries[key];
+        entry.hostname = hostname;
+        entry.port = port;
+        entry.hints = hints;
+        entry.addresses = resolved.first;
+        entry.result = resolved.second;
+        entry.expiry = std::chrono::steady_clock::now() + (resolved.second == 0 ? this->timeToLive : this->negativeTimeToLive);
+        entry.used = used;
+        return resolved;
+    }
+
+    /**
+     * Returns the cached result for the lookup, resolving it first if it is not cached or has expired.
+     *
+     * @return the same as *kt::resolveToAddresses()*.
+     */
+    std::pair<std::vector<kt::SocketAddress>, int> ResolverCache::resolve(const std::string& hostname, const unsigned short& port, const addrinfo& hints)
+    {
+        const std::string key = kt::detail::makeResolveKey(hostname, port, hints);
+        {
+            Stripe& stripe = this->getStripe(key);
+            std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+            auto entry = stripe.entries.find(key);
+            if (entry != stripe.entries.end() && std::chrono::steady_clock::now() < entry->second.expiry)
+            {
+                entry->second.used = true;
+                this->hits++;
+                return std::make_pair(entry->second.addresses, entry->second.result);
+            }
+        }
+
+        this->misses++;
+        return this->store(key, hostname, port, hints, true);
+    }
+
+    /**
+     * Resolves the name and caches the result, replacing any existing entry. Used to populate the cache before the first lookup,
+     * for example from a background thread at startup.
+     */
+    void ResolverCache::prefetch(const std::string& hostname, const unsigned short& port, const addrinfo& hints)
+    {
+        this->store(kt::detail::makeResolveKey(hostname, port, hints), hostname, port, hints, true);
+    }
+
+    /**
+     * Resolves again every successful entry that expires within the window and has been looked up since it was last refreshed.
+     * Expired entries that are no longer used are removed.
+     *
+     * @param window - The amount of microseconds from now within which an entry is considered about to expire.
+     *
+     * @return the amount of entries refreshed.
+     */
+    size_t ResolverCache::refresh(const long& window)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const std::chrono::steady_clock::time_point horizon = now + std::chrono::microseconds(window);
+        size_t refreshed = 0;
+
+        for (std::unique_ptr<Stripe>& stripe : this->stripes)
+        {
+            // Key, hostname, port and hints of the entries to resolve again once the lock is released
+            std::vector<std::tuple<std::string, std::string, unsigned short, addrinfo>> pending;
+            {
+                std::unique_lock<std::shared_mutex> lock(stripe->mutex);
+                for (auto entry = stripe->entries.begin(); entry != stripe->entries.end();)
+                {
+                    if (entry->second.expiry > horizon)
+                    {
+                        ++entry;
+                        continue;
+                    }
+
+                    if (entry->second.result == 0 && entry->second.used.exchange(false))
+                    {
+                        pending.emplace_back(entry->first, entry->second.hostname, entry->second.port, entry->second.hints);
+                        ++entry;
+                    }
+                    else if (entry->second.expiry <= now)
+                    {
+                        entry = stripe->entries.erase(entry);
+                    }
+                    else
+                    {
+                        ++entry;
+                    }
+                }
+            }
+
+            for (const std::tuple<std::string, std::string, unsigned short, addrinfo>& entry : pending)
+            {
+                this->store(std::get<0>(entry), std::get<1>(entry), std::get<2>(entry), std::get<3>(entry), false);
+                this->refreshes++;
+                refreshed++;
+            }
+        }
+        return refreshed;
+    }
+
+    /**
+     * Starts a thread that calls *refresh()* every interval, so names that are still being looked up are resolved again before they
+     * expire and lookups keep hitting the cache. Does nothing if the thread is already running.
+     *
+     * @param interval - The amount of microseconds between refreshes, this should be well below the time to live.
+     */
+    void ResolverCache::startRefreshing(const long& interval)
+    {
+        std::lock_guard<std::mutex> lock(this->refreshMutex);
+        if (this->refreshing)
+        {
+            return;
+        }
+
+        this->refreshing = true;
+        this->refreshThread = std::thread([this, interval]()
+        {
+            std::unique_lock<std::mutex> lock(this->refreshMutex);
+            while (!this->refreshCondition.wait_for(lock, std::chrono::microseconds(interval), [this]() { return !this->refreshing; }))
+            {
+                lock.unlock();
+                // Anything expiring before the refresh after next would otherwise be missed by a late wake up
+                this->refresh(interval * 2);
+                lock.lock();
+            }
+        });
+    }
+
+    void ResolverCache::stopRefreshing()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->refreshMutex);
+            if (!this->refreshing)
+            {
+                return;
+            }
+            this->refreshing = false;
+        }
+        this->refreshCondition.notify_all();
+        this->refreshThread.join();
+    }
+
+    /**
+     * Removes every entry for the hostname regardless of port and hints.
+     */
+    void ResolverCache::invalidate(const std::string& hostname)
+    {
+        for (std::unique_ptr<Stripe>& stripe : this->stripes)
+        {
+            std::unique_lock<std::shared_mutex> lock(stripe->mutex);
+            for (auto entry = stripe->entries.begin(); entry != stripe->entries.end();)
+            {
+                entry = entry->second.hostname == hostname ? stripe->entries.erase(entry) : std::next(entry);
+            }
+        }
+    }
+
+    void ResolverCache::clear()
+    {
+        for (std::unique_ptr<Stripe>& stripe : this->stripes)
+        {
+            std::unique_lock<std::shared_mutex> lock(stripe->mutex);
+            stripe->entries.clear();
+        }
+    }
+
+    /**
+     * @return the amount of cached entries, including expired ones that have not been removed yet.
+     */
+    size_t ResolverCache::size() const
+    {
+        size_t count = 0;
+        for (const std::unique_ptr<Stripe>& stripe : this->stripes)
+        {
+            std::shared_lock<std::shared_mutex> lock(stripe->mutex);
+            count += stripe->entries.size();
+        }
+        return count;
+    }
+
+    size_t ResolverCache::getHitCount() const
+    {
+        return this->hits;
+    }
+
+    size_t ResolverCache::getMissCount() const
+    {
+        return this->misses;
+    }
+
+    size_t ResolverCache::getRefreshCount() const
+    {
+        return this->refreshes;
+    }
+
+    /**
+     * Makes *kt::resolveToAddresses()*, and with it every socket in the library, resolve through the provided cache.
+     * Passing *nullptr* goes back to resolving every lookup.
+     */
+    void setResolverCache(const std::shared_ptr<kt::ResolverCache>& cache)
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        installedCache.store(cache);
+#else
+        std::lock_guard<std::mutex> lock(installedCacheMutex);
+        installedCache = cache;
+#endif
+    }
+
+    std::shared_ptr<kt::ResolverCache> getResolverCache()
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return installedCache.load();
+#else
+        std::lock_guard<std::mutex> lock(installedCacheMutex);
+        return installedCache;
+#endif
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "SocketAddress.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace kt
+{
+    namespace detail
+    {
+        std::string makeResolveKey(const std::string&, const unsigned short&, const addrinfo&);
+    }
+
+    /**
+     * Caches the results of *kt::resolveToAddresses()* keyed by hostname, port and the family, socket type, protocol and flags of the hints.
+     *
+     * *getaddrinfo()* does not expose the TTL of the DNS records it used, so entries live for a configured amount of time instead.
+     * Lookups that failed because the name does not exist are cached as well, for a separate and usually shorter time, so a bad name
+     * does not reach the resolver on every call. Temporary failures such as *EAI_AGAIN* are never cached.
+     *
+     * The entries are spread over several independently locked stripes and lookups only take a shared lock, so concurrent lookups
+     * do not contend unless they refresh the same stripe.
+     *
+     * Once installed with *kt::setResolverCache()* every socket in the library resolves through it.
+     * All methods may be called from any thread.
+     */
+    class ResolverCache
+    {
+        private:
+            struct Entry
+            {
+                std::string hostname;
+                unsigned short port = 0;
+                addrinfo hints{};
+                std::vector<kt::SocketAddress> addresses;
+                int result = 0;
+                std::chrono::steady_clock::time_point expiry;
+                // Set by lookups so background refreshing only keeps the entries that are still being used
+                mutable std::atomic<bool> used{true};
+            };
+
+            struct Stripe
+            {
+                mutable std::shared_mutex mutex;
+                std::unordered_map<std::string, Entry> entries;
+            };
+
+            std::chrono::microseconds timeToLive;
+            std::chrono::microseconds negativeTimeToLive;
+            std::vector<std::unique_ptr<Stripe>> stripes;
+
+            std::atomic<size_t> hits{0};
+            std::atomic<size_t> misses{0};
+            std::atomic<size_t> refreshes{0};
+
+            std::mutex refreshMutex;
+            std::condition_variable refreshCondition;
+            std::thread refreshThread;
+            bool refreshing = false;
+
+            Stripe& getStripe(const std::string&) const;
+            bool isCacheable(const int&) const;
+            std::pair<std::vector<kt::SocketAddress>, int> store(const std::string&, const std::string&, const unsigned short&, const addrinfo&, const bool&);
+
+        public:
+            ResolverCache(const long& = 30000000, const long& = 5000000, const unsigned int& = 16);
+            ~ResolverCache();
+
+            ResolverCache(const kt::ResolverCache&) = delete;
+            kt::ResolverCache& operator=(const kt::ResolverCache&) = delete;
+
+            std::pair<std::vector<kt::SocketAddress>, int> resolve(const std::string&, const unsigned short&, const addrinfo&);
+            void prefetch(const std::string&, const unsigned short&, const addrinfo&);
+            size_t refresh(const long&);
+
+            void startRefreshing(const long&);
+            void stopRefreshing();
+
+            void invalidate(const std::string&);
+            void clear();
+
+            size_t size() const;
+            size_t getHitCount() const;
+            size_t getMissCount() const;
+            size_t getRefreshCount() const;
+    };
+
+    void setResolverCache(const std::shared_ptr<kt::ResolverCache>&);
+
+    std::shared_ptr<kt::ResolverCache> getResolverCache();
+}
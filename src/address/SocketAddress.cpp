@@ -1,11 +1,128 @@
 #include "SocketAddress.h"
+#include "ResolverCache.h"
+#include "AddressLiteral.h"
 
+#include <array>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace kt
 {
+	namespace
+	{
+		struct DecimalOctet
+		{
+			char digits[3];
+			uint8_t length;
+		};
+
+		constexpr std::array<DecimalOctet, 256> createDecimalOctets()
+		{
+			std::array<DecimalOctet, 256> octets{};
+			for (unsigned int value = 0; value < octets.size(); value++)
+			{
+				DecimalOctet& octet = octets[value];
+				if (value >= 100)
+				{
+					octet.digits[octet.length++] = static_cast<char>('0' + (value / 100));
+				}
+				if (value >= 10)
+				{
+					octet.digits[octet.length++] = static_cast<char>('0' + ((value / 10) % 10));
+				}
+				octet.digits[octet.length++] = static_cast<char>('0' + (value % 10));
+			}
+			return octets;
+		}
+
+		// Every octet's decimal text, so formatting an IPv4 address is four table lookups and copies
+		constexpr std::array<DecimalOctet, 256> DECIMAL_OCTETS = createDecimalOctets();
+		constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+		char* formatIPv4(const uint8_t* bytes, char* out)
+		{
+			for (size_t i = 0; i < 4; i++)
+			{
+				if (i != 0)
+				{
+					*out++ = '.';
+				}
+				const DecimalOctet& octet = DECIMAL_OCTETS[bytes[i]];
+				std::memcpy(out, octet.digits, octet.length);
+				out += octet.length;
+			}
+			return out;
+		}
+
+		char* formatIPv6(const uint8_t* bytes, char* out)
+		{
+			uint16_t groups[8];
+			for (size_t i = 0; i < 8; i++)
+			{
+				groups[i] = static_cast<uint16_t>((bytes[i * 2] << 8) | bytes[(i * 2) + 1]);
+			}
+
+			// The first longest run of at least two zero groups is written as "::", matching inet_ntop()
+			size_t bestStart = 8;
+			size_t bestLength = 0;
+			for (size_t i = 0; i < 8;)
+			{
+				size_t length = 0;
+				while (i + length < 8 && groups[i + length] == 0)
+				{
+					length++;
+				}
+				if (length >= 2 && length > bestLength)
+				{
+					bestStart = i;
+					bestLength = length;
+				}
+				i += length == 0 ? 1 : length;
+			}
+
+			for (size_t i = 0; i < 8; i++)
+			{
+				if (i >= bestStart && i < bestStart + bestLength)
+				{
+					if (i == bestStart)
+					{
+						*out++ = ':';
+					}
+					continue;
+				}
+				if (i != 0)
+				{
+					*out++ = ':';
+				}
+				// IPv4-mapped and IPv4-compatible addresses end in dotted decimal
+				if (i == 6 && bestStart == 0 && (bestLength == 6 || (bestLength == 5 && groups[5] == 0xFFFF)))
+				{
+					return formatIPv4(bytes + 12, out);
+				}
+
+				bool leading = true;
+				for (int shift = 12; shift >= 0; shift -= 4)
+				{
+					const unsigned int nibble = (groups[i] >> shift) & 0xF;
+					if (leading && nibble == 0 && shift != 0)
+					{
+						continue;
+					}
+					leading = false;
+					*out++ = HEX_DIGITS[nibble];
+				}
+			}
+			if (bestLength > 0 && bestStart + bestLength == 8)
+			{
+				*out++ = ':';
+			}
+			return out;
+		}
+	}
+
 	kt::InternetProtocolVersion getInternetProtocolVersion(const kt::SocketAddress& address)
 	{
 		kt::InternetProtocolVersion resolvedVersion = static_cast<kt::InternetProtocolVersion>(address.address.sa_family);
@@ -31,28 +148,44 @@ namespace kt
 
 	std::optional<std::string> getAddress(const kt::SocketAddress& address)
 	{
+		char formatted[INET6_ADDRSTRLEN];
+		const std::string_view asString(formatted, kt::formatAddress(address, formatted, sizeof(formatted)));
+
+		// Since we zero out the address, we need to check its not default initialised
 		const kt::InternetProtocolVersion protocolVersion = getInternetProtocolVersion(address);
-		const size_t addressLength = protocolVersion == kt::InternetProtocolVersion::IPV6 ? INET6_ADDRSTRLEN : INET_ADDRSTRLEN;
-		std::string asString;
-		asString.resize(addressLength);
+		const std::string_view emptyAddress = protocolVersion == kt::InternetProtocolVersion::IPV6 ? "::" : "0.0.0.0";
+		return !asString.empty() && asString != emptyAddress ? std::optional<std::string>{asString} : std::nullopt;
+	}
 
-		if (protocolVersion == kt::InternetProtocolVersion::IPV6)
+	/**
+	 * Writes the textual form of the address into the buffer without allocating, producing the same text as *inet_ntop()*.
+	 * A buffer of *INET6_ADDRSTRLEN* characters fits any address.
+	 *
+	 * @return the amount of characters written, excluding the terminating null character, or 0 if the address is not an IPv4 or
+	 * IPv6 address or does not fit in the buffer.
+	 */
+	size_t formatAddress(const kt::SocketAddress& address, char* buffer, const size_t& bufferLength)
+	{
+		char formatted[INET6_ADDRSTRLEN];
+		char* end = formatted;
+		const kt::InternetProtocolVersion protocolVersion = getInternetProtocolVersion(address);
+		if (protocolVersion == kt::InternetProtocolVersion::IPV4)
 		{
-			inet_ntop(static_cast<int>(protocolVersion), &address.ipv6.sin6_addr, &asString[0], addressLength);
+			end = formatIPv4(reinterpret_cast<const uint8_t*>(&address.ipv4.sin_addr), formatted);
 		}
-		else
+		else if (protocolVersion == kt::InternetProtocolVersion::IPV6)
 		{
-			inet_ntop(static_cast<int>(protocolVersion), &address.ipv4.sin_addr, &asString[0], addressLength);
+			end = formatIPv6(reinterpret_cast<const uint8_t*>(&address.ipv6.sin6_addr), formatted);
 		}
 
-		// Removing trailing \0 bytes
-		const size_t delimiterIndex = asString.find_first_of('\0');
-		if (delimiterIndex != std::string::npos)
+		const size_t written = static_cast<size_t>(end - formatted);
+		if (written == 0 || written >= bufferLength)
 		{
-			asString = asString.substr(0, delimiterIndex);
+			return 0;
 		}
-		// Since we zero out the address, we need to check its not default initialised
-		return !asString.empty() && asString != getEmptyAddress(protocolVersion) ? std::optional<std::string>{asString} : std::nullopt;
+		std::memcpy(buffer, formatted, written);
+		buffer[written] = '\0';
+		return written;
 	}
 
 	std::pair<std::optional<kt::SocketAddress>, int> socketToAddress(const SOCKET& socket)
@@ -63,7 +196,36 @@ namespace kt
 		return std::make_pair(result == -1 ? std::nullopt : std::make_optional(address), result);
 	}
 
+	/**
+	 * Resolves the hostname and port using the provided hints. IP literals are converted directly without calling *getaddrinfo()*.
+	 * Otherwise, if a *kt::ResolverCache* has been installed with *kt::setResolverCache()* the lookup is answered from it instead.
+	 *
+	 * @return the resolved addresses and the result of *getaddrinfo()*, which is 0 on success.
+	 */
 	std::pair<std::vector<kt::SocketAddress>, int> resolveToAddresses(const std::string& hostname, const unsigned short& port, addrinfo& hints)
+	{
+		// Without a socket type getaddrinfo() returns one address per type, so only the usual single address case is short cut
+		if (hints.ai_socktype != 0 && (hints.ai_family == AF_UNSPEC || hints.ai_family == AF_INET || hints.ai_family == AF_INET6))
+		{
+			std::optional<kt::SocketAddress> literal = kt::parseAddressLiteral(hostname, port, static_cast<kt::InternetProtocolVersion>(hints.ai_family));
+			if (literal.has_value())
+			{
+				return std::make_pair(std::vector<kt::SocketAddress>{ literal.value() }, 0);
+			}
+		}
+
+		std::shared_ptr<kt::ResolverCache> cache = kt::getResolverCache();
+		if (cache != nullptr)
+		{
+			return cache->resolve(hostname, port, hints);
+		}
+		return kt::resolveToAddressesUncached(hostname, port, hints);
+	}
+
+	/**
+	 * Resolves the hostname and port using the provided hints, bypassing any installed *kt::ResolverCache*.
+	 */
+	std::pair<std::vector<kt::SocketAddress>, int> resolveToAddressesUncached(const std::string& hostname, const unsigned short& port, const addrinfo& hints)
 	{
 		std::vector<kt::SocketAddress> addresses;
 		addrinfo* resolvedAddresses = nullptr;
@@ -54,10 +54,14 @@ namespace kt
 
     std::optional<std::string> getAddress(const kt::SocketAddress&);
 
+    size_t formatAddress(const kt::SocketAddress&, char*, const size_t&);
+
     std::pair<std::optional<kt::SocketAddress>, int> socketToAddress(const SOCKET&);
 
     std::pair<std::vector<kt::SocketAddress>, int> resolveToAddresses(const std::string&, const unsigned short&, addrinfo&);
 
+    std::pair<std::vector<kt::SocketAddress>, int> resolveToAddressesUncached(const std::string&, const unsigned short&, const addrinfo&);
+
     addrinfo createUdpHints(const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any, const int = 0);
 
     addrinfo createTcpHints(const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any, const int = 0);
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace kt
+{
+    /**
+     * Describes why a partial send or receive returned.
+     */
+    enum class IOStatus
+    {
+        Complete, // The whole requested amount was transferred
+        WouldBlock, // The socket is non-blocking and no more could be transferred without waiting
+        Closed, // The remote closed or reset the connection
+        Timeout, // The deadline passed before the whole amount was transferred
+        Error // Any other failure, *kt::getErrorCode()* describes the cause
+    };
+}
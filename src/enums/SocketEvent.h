@@ -0,0 +1,33 @@
+#pragma once
+
+namespace kt
+{
+    /**
+     * Bit flags describing the readiness events a socket can be registered for, or has been notified of, by the *kt::EventLoop*.
+     */
+    enum class SocketEvent : unsigned int
+    {
+        None = 0,
+        Read = 1,
+        Write = 2,
+        Closed = 4,
+        Error = 8,
+        // Registration only flag, the socket is disabled after its first notification until it is re-armed with *modify()*
+        OneShot = 16
+    };
+
+    inline kt::SocketEvent operator|(const kt::SocketEvent lhs, const kt::SocketEvent rhs)
+    {
+        return static_cast<kt::SocketEvent>(static_cast<unsigned int>(lhs) | static_cast<unsigned int>(rhs));
+    }
+
+    inline kt::SocketEvent operator&(const kt::SocketEvent lhs, const kt::SocketEvent rhs)
+    {
+        return static_cast<kt::SocketEvent>(static_cast<unsigned int>(lhs) & static_cast<unsigned int>(rhs));
+    }
+
+    inline bool hasEvent(const kt::SocketEvent events, const kt::SocketEvent event)
+    {
+        return (events & event) != kt::SocketEvent::None;
+    }
+}
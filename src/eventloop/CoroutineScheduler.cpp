@@ -0,0 +1,217 @@
+#include "CoroutineScheduler.h"
+
+#include "../enums/IOStatus.h"
+#include "../socketexceptions/SocketException.hpp"
+
+#ifdef _WIN32
+
+#include <WinSock2.h>
+
+#else
+
+#include <sys/socket.h>
+
+#endif
+
+namespace kt
+{
+    namespace
+    {
+#ifdef __linux__
+        // Lets each operation be attempted without blocking even when the socket itself is in blocking mode
+        const int NO_WAIT = MSG_DONTWAIT;
+#else
+        const int NO_WAIT = 0;
+#endif
+    }
+
+    SocketReadiness::SocketReadiness(kt::CoroutineScheduler& scheduler, const SOCKET& socket, const kt::SocketEvent& events) : scheduler(scheduler), socket(socket), events(events) {}
+
+    void SocketReadiness::await_suspend(std::coroutine_handle<> handle)
+    {
+        kt::EventLoop& loop = this->scheduler.loop;
+        loop.add(this->socket, this->events, [this, &loop, handle](SOCKET socket, kt::SocketEvent occurred)
+        {
+            // The registration only lives for a single wait, the resumed coroutine registers again if it needs to
+            loop.remove(socket);
+            this->occurred = occurred;
+            handle.resume();
+        });
+    }
+
+    /**
+     * CoroutineScheduler constructor.
+     *
+     * @param maxEventsPerPoll - Passed to the underlying *kt::EventLoop*.
+     *
+     * @throw SocketException - When not running on Linux.
+     */
+    CoroutineScheduler::CoroutineScheduler(const unsigned int& maxEventsPerPoll) : loop(maxEventsPerPoll) {}
+
+    CoroutineScheduler::DetachedTask CoroutineScheduler::start(kt::Task<void> task)
+    {
+        try
+        {
+            co_await task;
+        }
+        catch (...)
+        {
+            if (!this->failure)
+            {
+                this->failure = std::current_exception();
+            }
+        }
+        this->activeTasks--;
+    }
+
+    /**
+     * Starts running the provided task on the calling thread until its first suspension point. The scheduler keeps the task alive
+     * until it completes. An exception escaping the task stops *run()* and is rethrown from it.
+     */
+    void CoroutineScheduler::spawn(kt::Task<void>&& task)
+    {
+        this->activeTasks++;
+        this->start(std::move(task));
+    }
+
+    kt::SocketReadiness CoroutineScheduler::readable(const SOCKET& socket)
+    {
+        return kt::SocketReadiness(*this, socket, kt::SocketEvent::Read);
+    }
+
+    kt::SocketReadiness CoroutineScheduler::writable(const SOCKET& socket)
+    {
+        return kt::SocketReadiness(*this, socket, kt::SocketEvent::Write);
+    }
+
+    /**
+     * Receives exactly the requested amount of characters, waiting on the loop whenever the socket has nothing more to read.
+     *
+     * @return the amount of characters received, which is less than requested if the connection was closed, or -1 if the receive
+     * failed before anything was received.
+     */
+    kt::Task<int> CoroutineScheduler::receiveAmountAsync(const kt::ConnectionOrientedSocket& socket, char* buffer, const int amountToReceive, const int flags)
+    {
+        int received = 0;
+        while (received < amountToReceive)
+        {
+            std::pair<int, kt::IOStatus> result = socket.receivePartial(buffer + received, amountToReceive - received, flags | NO_WAIT);
+            received += result.first;
+            if (result.second == kt::IOStatus::WouldBlock)
+            {
+                co_await this->readable(socket.getSocket());
+            }
+            else if (result.second == kt::IOStatus::Error)
+            {
+                co_return received == 0 ? -1 : received;
+            }
+            else if (result.second == kt::IOStatus::Closed)
+            {
+                break;
+            }
+        }
+        co_return received;
+    }
+
+    /**
+     * Sends the whole buffer, waiting on the loop whenever the socket's send buffer is full.
+     *
+     * @return the amount of characters sent, which is less than requested if the connection was closed or the send failed.
+     */
+    kt::Task<int> CoroutineScheduler::sendAsync(const kt::ConnectionOrientedSocket& socket, const char* buffer, const int amountToSend, const int flags)
+    {
+        int sent = 0;
+        while (sent < amountToSend)
+        {
+            std::pair<int, kt::IOStatus> result = socket.sendPartial(buffer + sent, amountToSend - sent, flags | NO_WAIT);
+            sent += result.first;
+            if (result.second == kt::IOStatus::WouldBlock)
+            {
+                co_await this->writable(socket.getSocket());
+            }
+            else if (result.second != kt::IOStatus::Complete)
+            {
+                break;
+            }
+        }
+        co_return sent;
+    }
+
+    /**
+     * Receives the next datagram on the bound socket, waiting on the loop until one arrives.
+     *
+     * @return the result of *kt::UDPSocket::receiveFrom()* for the received datagram.
+     */
+    kt::Task<std::pair<int, kt::SocketAddress>> CoroutineScheduler::receiveFromAsync(const kt::UDPSocket& socket, char* buffer, const int receiveLength, const int flags)
+    {
+        while (true)
+        {
+            std::pair<int, kt::SocketAddress> result = socket.receiveFrom(buffer, receiveLength, flags | NO_WAIT);
+            if (result.first >= 0 || isInvalidSocket(socket.getListeningSocket()) || !kt::isWouldBlockError())
+            {
+                co_return result;
+            }
+            co_await this->readable(socket.getListeningSocket());
+        }
+    }
+
+    /**
+     * Resumes the coroutines whose sockets became ready.
+     *
+     * @param timeout - The amount of microseconds to wait for a socket to become ready, a negative value waits indefinitely.
+     *
+     * @return the amount of coroutines resumed, or -1 if the wait failed.
+     */
+    int CoroutineScheduler::poll(const long& timeout)
+    {
+        return this->loop.poll(timeout);
+    }
+
+    /**
+     * Resumes coroutines until every spawned task has completed or *stop()* is called.
+     *
+     * @throw SocketException - If waiting for events fails.
+     * Any exception that escaped a spawned task is rethrown here.
+     */
+    void CoroutineScheduler::run()
+    {
+        while (this->activeTasks > 0 && !this->failure)
+        {
+            if (this->loop.poll() == -1)
+            {
+                throw kt::SocketException("Failed to wait for socket events: " + getErrorCode());
+            }
+            if (this->stopRequested)
+            {
+                break;
+            }
+        }
+        this->stopRequested = false;
+
+        if (this->failure)
+        {
+            std::exception_ptr failure = std::exchange(this->failure, nullptr);
+            std::rethrow_exception(failure);
+        }
+    }
+
+    /**
+     * Causes *run()* to return once the current set of coroutines have been resumed.
+     */
+    void CoroutineScheduler::stop()
+    {
+        this->stopRequested = true;
+        // The scheduler polls the loop itself, so stopping the loop would only leave a stop pending for a later EventLoop::run()
+        this->loop.wakeUp();
+    }
+
+    size_t CoroutineScheduler::getActiveTaskCount() const
+    {
+        return this->activeTasks;
+    }
+
+    kt::EventLoop& CoroutineScheduler::getEventLoop()
+    {
+        return this->loop;
+    }
+}
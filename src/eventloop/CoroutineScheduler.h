@@ -0,0 +1,106 @@
+#pragma once
+
+#include "EventLoop.h"
+#include "Task.h"
+#include "../socket/ConnectionOrientedSocket.h"
+#include "../socket/UDPSocket.h"
+#include "../serversocket/ServerSocket.h"
+#include "../enums/SocketEvent.h"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace kt
+{
+    class CoroutineScheduler;
+
+    /**
+     * Suspends the awaiting coroutine until the socket is ready for the requested events. Resumes with the events that occurred.
+     */
+    class SocketReadiness
+    {
+        private:
+            kt::CoroutineScheduler& scheduler;
+            SOCKET socket;
+            kt::SocketEvent events;
+            kt::SocketEvent occurred = kt::SocketEvent::None;
+
+        public:
+            SocketReadiness(kt::CoroutineScheduler&, const SOCKET&, const kt::SocketEvent&);
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<>);
+            kt::SocketEvent await_resume() const noexcept { return this->occurred; }
+    };
+
+    /**
+     * Runs coroutines on top of a *kt::EventLoop*, resuming them when the socket they are waiting on becomes ready.
+     * Operations are first attempted without blocking and only wait on the loop when the socket has no progress to offer, so a
+     * busy connection is served without any epoll calls.
+     *
+     * Only one operation may be awaited per socket at a time. All coroutines are resumed on the thread calling *run()* or *poll()*,
+     * and *stop()* is the only method that may be called from another thread. The sockets and buffers passed to the *Async* methods
+     * must stay valid until the returned task has completed.
+     *
+     * **CoroutineScheduler is only supported on Linux and requires the library to be built with CPPSOCKETLIBRARY_ENABLE_COROUTINES**
+     */
+    class CoroutineScheduler
+    {
+        private:
+            struct DetachedTask
+            {
+                struct promise_type
+                {
+                    DetachedTask get_return_object() const noexcept { return {}; }
+                    std::suspend_never initial_suspend() const noexcept { return {}; }
+                    std::suspend_never final_suspend() const noexcept { return {}; }
+                    void return_void() const noexcept {}
+                    void unhandled_exception() const noexcept { std::terminate(); }
+                };
+            };
+
+            kt::EventLoop loop;
+            size_t activeTasks = 0;
+            std::atomic<bool> stopRequested{false};
+            std::exception_ptr failure;
+
+            DetachedTask start(kt::Task<void>);
+
+            friend class SocketReadiness;
+
+        public:
+            CoroutineScheduler(const unsigned int& = 1024);
+
+            CoroutineScheduler(const kt::CoroutineScheduler&) = delete;
+            kt::CoroutineScheduler& operator=(const kt::CoroutineScheduler&) = delete;
+
+            void spawn(kt::Task<void>&&);
+
+            kt::SocketReadiness readable(const SOCKET&);
+            kt::SocketReadiness writable(const SOCKET&);
+
+            /**
+             * Accepts the next connection, waiting on the loop until one is available.
+             *
+             * @throw SocketException - If the connection cannot be accepted.
+             */
+            template <typename T>
+            kt::Task<T> acceptAsync(const kt::ServerSocket<T>& serverSocket)
+            {
+                co_await this->readable(serverSocket.getSocket());
+                co_return serverSocket.accept();
+            }
+
+            kt::Task<int> receiveAmountAsync(const kt::ConnectionOrientedSocket&, char*, const int, const int = 0);
+            kt::Task<int> sendAsync(const kt::ConnectionOrientedSocket&, const char*, const int, const int = 0);
+            kt::Task<std::pair<int, kt::SocketAddress>> receiveFromAsync(const kt::UDPSocket&, char*, const int, const int = 0);
+
+            int poll(const long& = -1);
+            void run();
+            void stop();
+            size_t getActiveTaskCount() const;
+            kt::EventLoop& getEventLoop();
+    };
+}
@@ -0,0 +1,351 @@
+#include "EventLoop.h"
+
+#include "../socketexceptions/SocketException.hpp"
+
+#include <cerrno>
+#include <cstdint>
+
+#ifdef __linux__
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#endif
+
+namespace kt
+{
+#ifdef __linux__
+    namespace
+    {
+        // Generation 0 is never handed out to a registration, so it is used to identify the wake up descriptor
+        const uint64_t WAKE_EVENT_DATA = 0;
+
+        uint32_t toEpollEvents(const kt::SocketEvent& events)
+        {
+            uint32_t epollEvents = 0;
+            if (kt::hasEvent(events, kt::SocketEvent::Read))
+            {
+                epollEvents |= EPOLLIN | EPOLLRDHUP;
+            }
+            if (kt::hasEvent(events, kt::SocketEvent::Write))
+            {
+                epollEvents |= EPOLLOUT;
+            }
+            if (kt::hasEvent(events, kt::SocketEvent::Closed))
+            {
+                epollEvents |= EPOLLRDHUP;
+            }
+            if (kt::hasEvent(events, kt::SocketEvent::OneShot))
+            {
+                epollEvents |= EPOLLONESHOT;
+            }
+            return epollEvents;
+        }
+
+        kt::SocketEvent fromEpollEvents(const uint32_t& epollEvents)
+        {
+            kt::SocketEvent events = kt::SocketEvent::None;
+            if ((epollEvents & EPOLLIN) != 0)
+            {
+                events = events | kt::SocketEvent::Read;
+            }
+            if ((epollEvents & EPOLLOUT) != 0)
+            {
+                events = events | kt::SocketEvent::Write;
+            }
+            if ((epollEvents & (EPOLLRDHUP | EPOLLHUP)) != 0)
+            {
+                events = events | kt::SocketEvent::Closed;
+            }
+            if ((epollEvents & EPOLLERR) != 0)
+            {
+                events = events | kt::SocketEvent::Error;
+            }
+            return events;
+        }
+    }
+#endif
+
+    /**
+     * EventLoop constructor. Creates the underlying epoll instance.
+     *
+     * @param maxEventsPerPoll - The largest amount of ready sockets that will be dispatched by a single call to *poll()*.
+     *
+     * @throw SocketException - If the epoll instance cannot be created, or when not running on Linux.
+     */
+    EventLoop::EventLoop(const unsigned int& maxEventsPerPoll) : maxEventsPerPoll(maxEventsPerPoll == 0 ? 1 : maxEventsPerPoll)
+    {
+#ifdef __linux__
+        this->epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+        if (isInvalidSocket(this->epollDescriptor))
+        {
+            throw kt::SocketException("Unable to create epoll instance: " + getErrorCode());
+        }
+
+        this->wakeDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (isInvalidSocket(this->wakeDescriptor))
+        {
+            this->close();
+            throw kt::SocketException("Unable to create event loop wake up descriptor: " + getErrorCode());
+        }
+
+        epoll_event wakeEvent{};
+        wakeEvent.events = EPOLLIN;
+        wakeEvent.data.u64 = WAKE_EVENT_DATA;
+        if (epoll_ctl(this->epollDescriptor, EPOLL_CTL_ADD, this->wakeDescriptor, &wakeEvent) != 0)
+        {
+            this->close();
+            throw kt::SocketException("Unable to register event loop wake up descriptor: " + getErrorCode());
+        }
+
+        this->events.resize(this->maxEventsPerPoll);
+#else
+        throw kt::SocketException("EventLoop is only supported on Linux.");
+#endif
+    }
+
+    EventLoop::~EventLoop()
+    {
+        this->close();
+    }
+
+    void EventLoop::update(const SOCKET& socket, const Registration& registration, const int& operation)
+    {
+#ifdef __linux__
+        epoll_event event{};
+        event.events = toEpollEvents(registration.events);
+        event.data.u64 = (static_cast<uint64_t>(registration.generation) << 32) | static_cast<uint32_t>(socket);
+        if (epoll_ctl(this->epollDescriptor, operation, socket, &event) != 0)
+        {
+            throw kt::SocketException("Unable to update event loop registration for socket " + std::to_string(socket) + ": " + getErrorCode());
+        }
+#endif
+    }
+
+    /**
+     * Registers the provided socket descriptor with this loop.
+     *
+     * @param socket - The descriptor to watch.
+     * @param events - The *kt::SocketEvent* flags that should trigger the callback. *Closed* and *Error* are always reported.
+     * @param callback - Invoked on the polling thread with the descriptor and the events that occurred.
+     *
+     * @throw SocketException - If the descriptor is invalid or is already registered.
+     */
+    void EventLoop::add(const SOCKET& socket, const kt::SocketEvent& events, const Callback& callback)
+    {
+        if (isInvalidSocket(socket))
+        {
+            throw kt::SocketException("Unable to register an invalid socket with the event loop.");
+        }
+
+        std::lock_guard<std::mutex> lock(this->registrationMutex);
+        if (this->registrations.find(socket) != this->registrations.end())
+        {
+            throw kt::SocketException("Socket " + std::to_string(socket) + " is already registered with the event loop.");
+        }
+
+        Registration registration;
+        registration.generation = this->nextGeneration++;
+        if (this->nextGeneration == 0)
+        {
+            this->nextGeneration = 1;
+        }
+        registration.events = events;
+        registration.callback = std::make_shared<Callback>(callback);
+
+#ifdef __linux__
+        this->update(socket, registration, EPOLL_CTL_ADD);
+#endif
+        this->registrations[socket] = registration;
+    }
+
+    void EventLoop::add(const kt::ConnectionOrientedSocket& socket, const kt::SocketEvent& events, const Callback& callback)
+    {
+        this->add(socket.getSocket(), events, callback);
+    }
+
+    void EventLoop::add(const kt::UDPSocket& socket, const kt::SocketEvent& events, const Callback& callback)
+    {
+        this->add(socket.getListeningSocket(), events, callback);
+    }
+
+    void EventLoop::add(const kt::DatagramIPCSocket& socket, const kt::SocketEvent& events, const Callback& callback)
+    {
+        this->add(socket.getListeningSocket(), events, callback);
+    }
+
+    /**
+     * Changes the events that a registered socket is watched for.
+     *
+     * @throw SocketException - If the socket is not registered with this loop.
+     */
+    void EventLoop::modify(const SOCKET& socket, const kt::SocketEvent& events)
+    {
+        std::lock_guard<std::mutex> lock(this->registrationMutex);
+        auto registration = this->registrations.find(socket);
+        if (registration == this->registrations.end())
+        {
+            throw kt::SocketException("Socket " + std::to_string(socket) + " is not registered with the event loop.");
+        }
+
+        registration->second.events = events;
+#ifdef __linux__
+        this->update(socket, registration->second, EPOLL_CTL_MOD);
+#endif
+    }
+
+    /**
+     * Stops watching the provided socket. Any events already collected for it in the current *poll()* are discarded.
+     * This must be called before the socket is closed, otherwise a new socket reusing the descriptor will not be registrable.
+     */
+    void EventLoop::remove(const SOCKET& socket)
+    {
+        std::lock_guard<std::mutex> lock(this->registrationMutex);
+        if (this->registrations.erase(socket) > 0)
+        {
+#ifdef __linux__
+            // Failures are ignored here since the descriptor may have already been closed, which removes it from the epoll set
+            epoll_ctl(this->epollDescriptor, EPOLL_CTL_DEL, socket, nullptr);
+#endif
+        }
+    }
+
+    bool EventLoop::contains(const SOCKET& socket) const
+    {
+        std::lock_guard<std::mutex> lock(this->registrationMutex);
+        return this->registrations.find(socket) != this->registrations.end();
+    }
+
+    size_t EventLoop::size() const
+    {
+        std::lock_guard<std::mutex> lock(this->registrationMutex);
+        return this->registrations.size();
+    }
+
+    /**
+     * Waits for registered sockets to become ready and invokes their callbacks on the calling thread.
+     * Callbacks are free to add, modify or remove registrations (including their own).
+     *
+     * @param timeout - The amount of microseconds to wait for an event, a negative value waits indefinitely.
+     *
+     * @return the amount of callbacks that were invoked, or -1 if the wait failed.
+     */
+    int EventLoop::poll(const long& timeout)
+    {
+#ifdef __linux__
+        const int milliseconds = timeout < 0 ? -1 : static_cast<int>((timeout + 999) / 1000);
+        int ready = epoll_wait(this->epollDescriptor, this->events.data(), static_cast<int>(this->events.size()), milliseconds);
+        if (ready < 0)
+        {
+            return errno == EINTR ? 0 : -1;
+        }
+
+        int dispatched = 0;
+        for (int i = 0; i < ready; i++)
+        {
+            const uint64_t data = this->events[i].data.u64;
+            if (data == WAKE_EVENT_DATA)
+            {
+                uint64_t counter = 0;
+                while (read(this->wakeDescriptor, &counter, sizeof(counter)) > 0) {}
+                continue;
+            }
+
+            const SOCKET socket = static_cast<SOCKET>(static_cast<uint32_t>(data & 0xFFFFFFFF));
+            const unsigned int generation = static_cast<unsigned int>(data >> 32);
+
+            std::shared_ptr<Callback> callback;
+            {
+                std::lock_guard<std::mutex> lock(this->registrationMutex);
+                auto registration = this->registrations.find(socket);
+                // Skip events for sockets that were removed (or removed and re-added) by an earlier callback in this batch
+                if (registration == this->registrations.end() || registration->second.generation != generation)
+                {
+                    continue;
+                }
+                callback = registration->second.callback;
+            }
+
+            (*callback)(socket, fromEpollEvents(this->events[i].events));
+            dispatched++;
+        }
+        return dispatched;
+#else
+        return -1;
+#endif
+    }
+
+    /**
+     * Repeatedly calls *poll()* until *stop()* is called, from a callback or from another thread. If *stop()* was called while the
+     * loop was not running, this returns without dispatching anything.
+     *
+     * @throw SocketException - If waiting for events fails.
+     */
+    void EventLoop::run()
+    {
+        this->running = true;
+        while (!this->stopRequested)
+        {
+            if (this->poll() == -1)
+            {
+                this->stopRequested = false;
+                this->running = false;
+                throw kt::SocketException("Failed to wait for socket events: " + getErrorCode());
+            }
+        }
+        this->stopRequested = false;
+        this->running = false;
+    }
+
+    /**
+     * Causes *run()* to return once the current set of callbacks have finished, or the next call to *run()* to return straight
+     * away when it has not started yet. Safe to call from any thread.
+     */
+    void EventLoop::stop()
+    {
+        this->stopRequested = true;
+        this->wakeUp();
+    }
+
+    /**
+     * Causes a *poll()* that is currently waiting to return early, or the next one to return immediately. Safe to call from any thread.
+     */
+    void EventLoop::wakeUp()
+    {
+#ifdef __linux__
+        const uint64_t increment = 1;
+        // A failed write means the counter is already non-zero, so the loop will still be woken up
+        ssize_t written = write(this->wakeDescriptor, &increment, sizeof(increment));
+        (void)written;
+#endif
+    }
+
+    bool EventLoop::isRunning() const
+    {
+        return this->running;
+    }
+
+    /**
+     * Closes the underlying epoll instance and forgets all registrations. The registered sockets themselves are left open.
+     */
+    void EventLoop::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->registrationMutex);
+            this->registrations.clear();
+        }
+
+#ifdef __linux__
+        if (!isInvalidSocket(this->wakeDescriptor))
+        {
+            ::close(this->wakeDescriptor);
+            this->wakeDescriptor = getInvalidSocketValue();
+        }
+        if (!isInvalidSocket(this->epollDescriptor))
+        {
+            ::close(this->epollDescriptor);
+            this->epollDescriptor = getInvalidSocketValue();
+        }
+#endif
+    }
+}
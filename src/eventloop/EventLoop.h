@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../socket/Socket.h"
+#include "../socket/ConnectionOrientedSocket.h"
+#include "../socket/UDPSocket.h"
+#include "../serversocket/ServerSocket.h"
+#include "../ipc/DatagramIPCSocket.h"
+#include "../enums/SocketEvent.h"
+#include "../socketexceptions/SocketError.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+
+#endif
+
+namespace kt
+{
+    /**
+     * An epoll backed reactor that dispatches read and write readiness for many sockets from a single thread.
+     * Sockets are registered by descriptor, so copies of the same socket share a single registration.
+     *
+     * **EventLoop is only supported on Linux**
+     */
+    class EventLoop
+    {
+        public:
+            typedef std::function<void(SOCKET, kt::SocketEvent)> Callback;
+
+        private:
+            struct Registration
+            {
+                unsigned int generation = 0;
+                kt::SocketEvent events = kt::SocketEvent::None;
+                std::shared_ptr<Callback> callback;
+            };
+
+            SOCKET epollDescriptor = getInvalidSocketValue();
+            SOCKET wakeDescriptor = getInvalidSocketValue();
+            unsigned int maxEventsPerPoll;
+            unsigned int nextGeneration = 1;
+            std::atomic<bool> running{false};
+            // Kept separate from running so a stop() that arrives before run() has started is not lost
+            std::atomic<bool> stopRequested{false};
+
+            mutable std::mutex registrationMutex;
+            std::unordered_map<SOCKET, Registration> registrations;
+
+#ifdef __linux__
+            std::vector<epoll_event> events;
+#endif
+
+            void update(const SOCKET&, const Registration&, const int&);
+
+        public:
+            EventLoop(const unsigned int& = 1024);
+            ~EventLoop();
+
+            EventLoop(const kt::EventLoop&) = delete;
+            kt::EventLoop& operator=(const kt::EventLoop&) = delete;
+
+            void add(const SOCKET&, const kt::SocketEvent&, const Callback&);
+            void add(const kt::ConnectionOrientedSocket&, const kt::SocketEvent&, const Callback&);
+            void add(const kt::UDPSocket&, const kt::SocketEvent&, const Callback&);
+            void add(const kt::DatagramIPCSocket&, const kt::SocketEvent&, const Callback&);
+
+            template <typename T>
+            void add(const kt::ServerSocket<T>& serverSocket, const kt::SocketEvent& events, const Callback& callback)
+            {
+                this->add(serverSocket.getSocket(), events, callback);
+            }
+
+            void modify(const SOCKET&, const kt::SocketEvent&);
+            void remove(const SOCKET&);
+            bool contains(const SOCKET&) const;
+            size_t size() const;
+
+            int poll(const long& = -1);
+            void run();
+            void stop();
+            void wakeUp();
+            bool isRunning() const;
+
+            void close();
+    };
+}
@@ -0,0 +1,502 @@
+#include "IOUringEngine.h"
+
+#include "../socketexceptions/SocketException.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+
+#include <WinSock2.h>
+
+#else
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#endif
+
+#ifdef CPPSOCKETLIBRARY_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#endif
+
+namespace kt
+{
+#ifdef CPPSOCKETLIBRARY_IO_URING
+    namespace
+    {
+        const unsigned short RECEIVE_BUFFER_GROUP = 1;
+        const unsigned int OPERATION_SHIFT = 56;
+        const uint64_t USER_DATA_MASK = (static_cast<uint64_t>(1) << OPERATION_SHIFT) - 1;
+
+        void* mapRing(const SOCKET& ringDescriptor, const size_t& size, const off_t& offset)
+        {
+            void* ring = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringDescriptor, offset);
+            return ring == MAP_FAILED ? nullptr : ring;
+        }
+
+        template <typename T>
+        T* ringField(void* ring, const unsigned int& offset)
+        {
+            return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+        }
+    }
+#endif
+
+    /**
+     * IOUringEngine constructor. Creates the ring and registers the receive buffer pool with the kernel.
+     *
+     * @param entries - The size of the submission queue, the amount of operations that can be queued between calls to *submit()*.
+     * @param receiveBufferCount - The amount of buffers the kernel can pick from for receives, 0 disables the pool.
+     * @param receiveBufferSize - The size of each pooled receive buffer.
+     *
+     * @throw SocketException - If the ring cannot be created, or when io_uring support was not available at build time.
+     */
+    IOUringEngine::IOUringEngine(const unsigned int& entries, const unsigned int& receiveBufferCount, const unsigned int& receiveBufferSize)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        if (receiveBufferCount > 0xFFFF || (receiveBufferCount > 0 && receiveBufferSize == 0))
+        {
+            throw kt::SocketException("Receive buffer count must be at most 65535 with a non-zero buffer size.");
+        }
+
+        io_uring_params parameters{};
+        this->ringDescriptor = static_cast<SOCKET>(syscall(__NR_io_uring_setup, entries == 0 ? 1 : entries, &parameters));
+        if (isInvalidSocket(this->ringDescriptor))
+        {
+            throw kt::SocketException("Unable to create io_uring instance: " + getErrorCode());
+        }
+        this->submissionEntryCount = parameters.sq_entries;
+
+        this->submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned int);
+        this->completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMapping = (parameters.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMapping)
+        {
+            this->submissionRingSize = std::max(this->submissionRingSize, this->completionRingSize);
+            this->completionRingSize = 0;
+        }
+
+        this->submissionRing = mapRing(this->ringDescriptor, this->submissionRingSize, IORING_OFF_SQ_RING);
+        this->completionRing = singleMapping ? this->submissionRing : mapRing(this->ringDescriptor, this->completionRingSize, IORING_OFF_CQ_RING);
+        this->submissionEntriesSize = parameters.sq_entries * sizeof(io_uring_sqe);
+        this->submissionEntries = static_cast<io_uring_sqe*>(mapRing(this->ringDescriptor, this->submissionEntriesSize, IORING_OFF_SQES));
+        if (this->submissionRing == nullptr || this->completionRing == nullptr || this->submissionEntries == nullptr)
+        {
+            const std::string error = getErrorCode();
+            this->close();
+            throw kt::SocketException("Unable to map io_uring queues: " + error);
+        }
+
+        this->submissionHead = ringField<unsigned int>(this->submissionRing, parameters.sq_off.head);
+        this->submissionTail = ringField<unsigned int>(this->submissionRing, parameters.sq_off.tail);
+        this->submissionMask = ringField<unsigned int>(this->submissionRing, parameters.sq_off.ring_mask);
+        this->submissionArray = ringField<unsigned int>(this->submissionRing, parameters.sq_off.array);
+        this->completionHead = ringField<unsigned int>(this->completionRing, parameters.cq_off.head);
+        this->completionTail = ringField<unsigned int>(this->completionRing, parameters.cq_off.tail);
+        this->completionMask = ringField<unsigned int>(this->completionRing, parameters.cq_off.ring_mask);
+        this->completionEntries = ringField<io_uring_cqe>(this->completionRing, parameters.cq_off.cqes);
+
+        if (receiveBufferCount > 0)
+        {
+            this->receiveBufferCount = receiveBufferCount;
+            this->receiveBufferSize = receiveBufferSize;
+            this->receiveBuffers.resize(static_cast<size_t>(receiveBufferCount) * receiveBufferSize);
+            this->provideReceiveBuffers(0, static_cast<unsigned short>(receiveBufferCount));
+
+            // Wait for the buffers to be registered so kernels without buffer selection are reported here rather than on the first receive
+            std::vector<kt::IOUringCompletion> completions;
+            if (this->submitAndWait(1) < 0)
+            {
+                const std::string error = getErrorCode();
+                this->close();
+                throw kt::SocketException("Unable to register io_uring receive buffers: " + error);
+            }
+
+            this->drainCompletions(completions);
+            if (this->provideBuffersResult < 0)
+            {
+                const int error = this->provideBuffersResult;
+                this->close();
+                throw kt::SocketException("Unable to register io_uring receive buffers: " + std::string(std::strerror(-error)));
+            }
+        }
+#else
+        throw kt::SocketException("IOUringEngine is only supported on Linux when built with io_uring support.");
+#endif
+    }
+
+    IOUringEngine::~IOUringEngine()
+    {
+        this->close();
+    }
+
+    /**
+     * Reserves the next submission queue entry and publishes it to the kernel, submitting the queue first if it is full.
+     * Without SQPOLL the kernel only reads entries during *io_uring_enter()*, so the entry can be filled in after it is published.
+     */
+    io_uring_sqe* IOUringEngine::getSubmissionEntry(const kt::IOUringOperation& operation, const uint64_t& userData)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        if (isInvalidSocket(this->ringDescriptor))
+        {
+            throw kt::SocketException("Unable to queue an operation on a closed io_uring engine.");
+        }
+        if ((userData & ~USER_DATA_MASK) != 0)
+        {
+            throw kt::SocketException("io_uring user data must fit within 56 bits.");
+        }
+
+        const unsigned int tail = *this->submissionTail;
+        if (tail - __atomic_load_n(this->submissionHead, __ATOMIC_ACQUIRE) >= this->submissionEntryCount)
+        {
+            this->submit();
+            if (tail - __atomic_load_n(this->submissionHead, __ATOMIC_ACQUIRE) >= this->submissionEntryCount)
+            {
+                throw kt::SocketException("io_uring submission queue is full.");
+            }
+        }
+
+        const unsigned int index = tail & *this->submissionMask;
+        io_uring_sqe* entry = &this->submissionEntries[index];
+        std::memset(entry, 0, sizeof(io_uring_sqe));
+        entry->user_data = (static_cast<uint64_t>(operation) << OPERATION_SHIFT) | userData;
+        this->submissionArray[index] = index;
+        __atomic_store_n(this->submissionTail, tail + 1, __ATOMIC_RELEASE);
+        this->pendingSubmissions++;
+        return entry;
+#else
+        return nullptr;
+#endif
+    }
+
+    void IOUringEngine::provideReceiveBuffers(const unsigned short& firstBufferId, const unsigned short& count)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        io_uring_sqe* entry = this->getSubmissionEntry(kt::IOUringOperation::ProvideBuffers, 0);
+        entry->opcode = IORING_OP_PROVIDE_BUFFERS;
+        entry->fd = count;
+        entry->addr = reinterpret_cast<uint64_t>(this->receiveBuffers.data() + static_cast<size_t>(firstBufferId) * this->receiveBufferSize);
+        entry->len = this->receiveBufferSize;
+        entry->off = firstBufferId;
+        entry->buf_group = RECEIVE_BUFFER_GROUP;
+#endif
+    }
+
+    int IOUringEngine::enter(const unsigned int& toSubmit, const unsigned int& minimumCompletions, const unsigned int& flags)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        int result = 0;
+        do
+        {
+            result = static_cast<int>(syscall(__NR_io_uring_enter, this->ringDescriptor, toSubmit, minimumCompletions, flags, nullptr, 0));
+        } while (result < 0 && errno == EINTR);
+
+        if (result > 0)
+        {
+            this->pendingSubmissions -= std::min(this->pendingSubmissions, static_cast<unsigned int>(result));
+        }
+        return result;
+#else
+        return -1;
+#endif
+    }
+
+    /**
+     * Queues a single accept on the provided server socket. The completion result is the accepted descriptor, see *toTCPSocket()*.
+     */
+    void IOUringEngine::accept(const kt::TCPServerSocket& serverSocket, const uint64_t& userData)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        io_uring_sqe* entry = this->getSubmissionEntry(kt::IOUringOperation::Accept, userData);
+        entry->opcode = IORING_OP_ACCEPT;
+        entry->fd = serverSocket.getSocket();
+#endif
+    }
+
+    /**
+     * Queues a multishot accept on the provided server socket. A completion is produced for every accepted connection while
+     * *more* is set on the completion, once it is cleared the accept must be queued again.
+     */
+    void IOUringEngine::acceptMultishot(const kt::TCPServerSocket& serverSocket, const uint64_t& userData)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        io_uring_sqe* entry = this->getSubmissionEntry(kt::IOUringOperation::Accept, userData);
+        entry->opcode = IORING_OP_ACCEPT;
+        entry->fd = serverSocket.getSocket();
+        entry->ioprio = IORING_ACCEPT_MULTISHOT;
+#endif
+    }
+
+    /**
+     * Queues a receive into one of the engine's pooled receive buffers. The buffer used is reported through the completion's
+     * *bufferId* and must be returned with *releaseReceiveBuffer()*.
+     *
+     * @throw SocketException - If the engine was created without a receive buffer pool.
+     */
+    void IOUringEngine::receive(const kt::ConnectionOrientedSocket& socket, const uint64_t& userData, const int& flags)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        if (this->receiveBufferCount == 0)
+        {
+            throw kt::SocketException("Unable to receive into the buffer pool as the engine was created without receive buffers.");
+        }
+
+        io_uring_sqe* entry = this->getSubmissionEntry(kt::IOUringOperation::Receive, userData);
+        entry->opcode = IORING_OP_RECV;
+        entry->fd = socket.getSocket();
+        entry->len = this->receiveBufferSize;
+        entry->msg_flags = static_cast<unsigned int>(flags);
+        entry->flags = IOSQE_BUFFER_SELECT;
+        entry->buf_group = RECEIVE_BUFFER_GROUP;
+#endif
+    }
+
+    /**
+     * Queues a receive into the provided buffer, which must stay valid until the completion has been drained.
+     */
+    void IOUringEngine::receive(const kt::ConnectionOrientedSocket& socket, char* buffer, const unsigned int& length, const uint64_t& userData, const int& flags)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        io_uring_sqe* entry = this->getSubmissionEntry(kt::IOUringOperation::Receive, userData);
+        entry->opcode = IORING_OP_RECV;
+        entry->fd = socket.getSocket();
+        entry->addr = reinterpret_cast<uint64_t>(buffer);
+        entry->len = length;
+        entry->msg_flags = static_cast<unsigned int>(flags);
+#endif
+    }
+
+    /**
+     * Queues a send of the provided buffer, which must stay valid until the completion has been drained.
+     */
+    void IOUringEngine::send(const kt::ConnectionOrientedSocket& socket, const char* buffer, const unsigned int& length, const uint64_t& userData, const int& flags)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        io_uring_sqe* entry = this->getSubmissionEntry(kt::IOUringOperation::Send, userData);
+        entry->opcode = IORING_OP_SEND;
+        entry->fd = socket.getSocket();
+        entry->addr = reinterpret_cast<uint64_t>(buffer);
+        entry->len = length;
+        entry->msg_flags = static_cast<unsigned int>(flags);
+#endif
+    }
+
+    /**
+     * Queues a *recvmsg()* on the provided bound UDP socket. The message header and the buffers it references must stay valid until
+     * the completion has been drained, the sender is written to *msg_name*.
+     *
+     * @throw SocketException - If the socket is not bound.
+     */
+    void IOUringEngine::receiveMessage(const kt::UDPSocket& socket, msghdr* message, const uint64_t& userData, const int& flags)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        if (isInvalidSocket(socket.getListeningSocket()))
+        {
+            throw kt::SocketException("Unable to queue a receive on a UDP socket that is not bound.");
+        }
+
+        io_uring_sqe* entry = this->getSubmissionEntry(kt::IOUringOperation::ReceiveMessage, userData);
+        entry->opcode = IORING_OP_RECVMSG;
+        entry->fd = socket.getListeningSocket();
+        entry->addr = reinterpret_cast<uint64_t>(message);
+        entry->len = 1;
+        entry->msg_flags = static_cast<unsigned int>(flags);
+#endif
+    }
+
+    /**
+     * Queues a *sendmsg()* from the provided bound UDP socket, so the datagram is sent from its bound address. The message header and
+     * the buffers it references must stay valid until the completion has been drained.
+     *
+     * @throw SocketException - If the socket is not bound.
+     */
+    void IOUringEngine::sendMessage(const kt::UDPSocket& socket, const msghdr* message, const uint64_t& userData, const int& flags)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        if (isInvalidSocket(socket.getListeningSocket()))
+        {
+            throw kt::SocketException("Unable to queue a send on a UDP socket that is not bound.");
+        }
+
+        io_uring_sqe* entry = this->getSubmissionEntry(kt::IOUringOperation::SendMessage, userData);
+        entry->opcode = IORING_OP_SENDMSG;
+        entry->fd = socket.getListeningSocket();
+        entry->addr = reinterpret_cast<uint64_t>(message);
+        entry->len = 1;
+        entry->msg_flags = static_cast<unsigned int>(flags);
+#endif
+    }
+
+    /**
+     * Hands every queued operation to the kernel in a single system call without waiting for any of them to complete.
+     *
+     * @return the amount of operations submitted, or -1 if the submission failed.
+     */
+    int IOUringEngine::submit()
+    {
+        if (this->pendingSubmissions == 0)
+        {
+            return 0;
+        }
+        return this->enter(this->pendingSubmissions, 0, 0);
+    }
+
+    /**
+     * Submits every queued operation and waits until at least the requested amount of completions are ready to be drained.
+     *
+     * @return the amount of operations submitted, or -1 if the submission or wait failed.
+     */
+    int IOUringEngine::submitAndWait(const unsigned int& minimumCompletions)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        return this->enter(this->pendingSubmissions, minimumCompletions, IORING_ENTER_GETEVENTS);
+#else
+        return -1;
+#endif
+    }
+
+    /**
+     * Appends every completion that is currently ready to the provided vector. This does not block, use *submitAndWait()* to wait
+     * for completions.
+     *
+     * @return the amount of completions appended.
+     */
+    size_t IOUringEngine::drainCompletions(std::vector<kt::IOUringCompletion>& completions)
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        if (isInvalidSocket(this->ringDescriptor))
+        {
+            return 0;
+        }
+
+        const size_t initialSize = completions.size();
+        unsigned int head = *this->completionHead;
+        const unsigned int tail = __atomic_load_n(this->completionTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++)
+        {
+            const io_uring_cqe& entry = static_cast<io_uring_cqe*>(this->completionEntries)[head & *this->completionMask];
+            const kt::IOUringOperation operation = static_cast<kt::IOUringOperation>(entry.user_data >> OPERATION_SHIFT);
+            if (operation == kt::IOUringOperation::ProvideBuffers)
+            {
+                this->provideBuffersResult = entry.res;
+                continue;
+            }
+
+            kt::IOUringCompletion completion;
+            completion.operation = operation;
+            completion.userData = entry.user_data & USER_DATA_MASK;
+            completion.result = entry.res;
+            if ((entry.flags & IORING_CQE_F_BUFFER) != 0)
+            {
+                completion.bufferId = static_cast<unsigned short>(entry.flags >> IORING_CQE_BUFFER_SHIFT);
+            }
+            completion.more = (entry.flags & IORING_CQE_F_MORE) != 0;
+            completions.push_back(completion);
+        }
+        __atomic_store_n(this->completionHead, head, __ATOMIC_RELEASE);
+
+        return completions.size() - initialSize;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @return the start of the pooled receive buffer with the provided id, or *nullptr* if the id is not part of the pool.
+     */
+    const char* IOUringEngine::getReceiveBuffer(const unsigned short& bufferId) const
+    {
+        if (bufferId >= this->receiveBufferCount)
+        {
+            return nullptr;
+        }
+        return this->receiveBuffers.data() + static_cast<size_t>(bufferId) * this->receiveBufferSize;
+    }
+
+    unsigned int IOUringEngine::getReceiveBufferSize() const
+    {
+        return this->receiveBufferSize;
+    }
+
+    /**
+     * Hands a pooled receive buffer back to the kernel so it can be selected by later receives. This is queued alongside the other
+     * operations and takes effect on the next submission.
+     */
+    void IOUringEngine::releaseReceiveBuffer(const unsigned short& bufferId)
+    {
+        if (bufferId < this->receiveBufferCount)
+        {
+            this->provideReceiveBuffers(bufferId, 1);
+        }
+    }
+
+    /**
+     * Wraps the descriptor produced by an accept completion in a *kt::TCPSocket*.
+     *
+     * @param completion - A completed accept operation.
+     * @param serverSocket - The server socket the accept was queued on.
+     *
+     * @throw SocketException - If the accept failed or the remote address of the connection cannot be determined.
+     */
+    kt::TCPSocket IOUringEngine::toTCPSocket(const kt::IOUringCompletion& completion, const kt::TCPServerSocket& serverSocket) const
+    {
+        if (completion.operation != kt::IOUringOperation::Accept || completion.result < 0)
+        {
+            throw kt::SocketException("Failed to accept connection: " + std::string(std::strerror(-completion.result)));
+        }
+
+        const SOCKET accepted = static_cast<SOCKET>(completion.result);
+        kt::SocketAddress acceptedAddress{};
+        socklen_t sockLen = sizeof(acceptedAddress);
+        if (getpeername(accepted, &acceptedAddress.address, &sockLen) != 0)
+        {
+            const std::string error = getErrorCode();
+#ifdef _WIN32
+            closesocket(accepted);
+#else
+            ::close(accepted);
+#endif
+            throw kt::SocketException("Unable to determine the remote address of the accepted socket: " + error);
+        }
+
+        return kt::TCPSocket(accepted, std::string(), static_cast<unsigned short>(kt::getPortNumber(acceptedAddress)), serverSocket.getInternetProtocolVersion(), acceptedAddress);
+    }
+
+    /**
+     * Unmaps the queues and closes the ring. Operations that are still in flight are cancelled by the kernel, the sockets themselves
+     * are left open.
+     */
+    void IOUringEngine::close()
+    {
+#ifdef CPPSOCKETLIBRARY_IO_URING
+        if (this->submissionEntries != nullptr)
+        {
+            munmap(this->submissionEntries, this->submissionEntriesSize);
+            this->submissionEntries = nullptr;
+        }
+        if (this->completionRing != nullptr && this->completionRing != this->submissionRing)
+        {
+            munmap(this->completionRing, this->completionRingSize);
+        }
+        this->completionRing = nullptr;
+        if (this->submissionRing != nullptr)
+        {
+            munmap(this->submissionRing, this->submissionRingSize);
+            this->submissionRing = nullptr;
+        }
+        if (!isInvalidSocket(this->ringDescriptor))
+        {
+            ::close(this->ringDescriptor);
+            this->ringDescriptor = getInvalidSocketValue();
+        }
+#endif
+        this->pendingSubmissions = 0;
+        this->receiveBufferCount = 0;
+    }
+}
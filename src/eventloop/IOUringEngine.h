@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../socket/Socket.h"
+#include "../socket/ConnectionOrientedSocket.h"
+#include "../socket/TCPSocket.h"
+#include "../socket/UDPSocket.h"
+#include "../serversocket/TCPServerSocket.h"
+#include "../socketexceptions/SocketError.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+struct io_uring_sqe;
+struct msghdr;
+
+namespace kt
+{
+    enum class IOUringOperation : uint8_t
+    {
+        Accept = 1,
+        Receive = 2,
+        Send = 3,
+        ReceiveMessage = 4,
+        SendMessage = 5,
+
+        // Internal operations, completions for these are never returned to the caller
+        ProvideBuffers = 255
+    };
+
+    /**
+     * The outcome of a single operation submitted to a *kt::IOUringEngine*.
+     */
+    struct IOUringCompletion
+    {
+        kt::IOUringOperation operation = kt::IOUringOperation::Accept;
+        // The value provided when the operation was queued
+        uint64_t userData = 0;
+        // The amount of bytes transferred, the accepted descriptor for accepts, or a negated errno value on failure
+        int result = 0;
+        // Set for receives that used one of the engine's registered receive buffers, see *getReceiveBuffer()*
+        std::optional<unsigned short> bufferId = std::nullopt;
+        // *true* while a multishot operation will keep producing completions
+        bool more = false;
+    };
+
+    /**
+     * An io_uring backed I/O engine. Operations for the existing socket classes are queued as submission entries, handed to the
+     * kernel in a single call by *submit()*, and their results are collected with *drainCompletions()* once per loop iteration.
+     *
+     * Receives that do not provide their own buffer are served from a pool of buffers registered with the kernel, the buffer must
+     * be handed back with *releaseReceiveBuffer()* once its contents have been consumed.
+     *
+     * Any buffers or message headers passed to an operation must stay valid until its completion has been drained.
+     * *userData* values are limited to 56 bits, the remaining bits identify the operation.
+     *
+     * **IOUringEngine is only supported on Linux, when the kernel io_uring headers are available at build time**
+     */
+    class IOUringEngine
+    {
+        private:
+            SOCKET ringDescriptor = getInvalidSocketValue();
+            unsigned int submissionEntryCount = 0;
+            unsigned int pendingSubmissions = 0;
+
+            void* submissionRing = nullptr;
+            size_t submissionRingSize = 0;
+            void* completionRing = nullptr;
+            size_t completionRingSize = 0;
+            io_uring_sqe* submissionEntries = nullptr;
+            size_t submissionEntriesSize = 0;
+
+            unsigned int* submissionHead = nullptr;
+            unsigned int* submissionTail = nullptr;
+            unsigned int* submissionMask = nullptr;
+            unsigned int* submissionArray = nullptr;
+            unsigned int* completionHead = nullptr;
+            unsigned int* completionTail = nullptr;
+            unsigned int* completionMask = nullptr;
+            void* completionEntries = nullptr;
+
+            std::vector<char> receiveBuffers;
+            unsigned int receiveBufferCount = 0;
+            unsigned int receiveBufferSize = 0;
+            int provideBuffersResult = 0;
+
+            io_uring_sqe* getSubmissionEntry(const kt::IOUringOperation&, const uint64_t&);
+            void provideReceiveBuffers(const unsigned short&, const unsigned short&);
+            int enter(const unsigned int&, const unsigned int&, const unsigned int&);
+
+        public:
+            IOUringEngine(const unsigned int& = 256, const unsigned int& = 64, const unsigned int& = 4096);
+            ~IOUringEngine();
+
+            IOUringEngine(const kt::IOUringEngine&) = delete;
+            kt::IOUringEngine& operator=(const kt::IOUringEngine&) = delete;
+
+            void accept(const kt::TCPServerSocket&, const uint64_t&);
+            void acceptMultishot(const kt::TCPServerSocket&, const uint64_t&);
+            void receive(const kt::ConnectionOrientedSocket&, const uint64_t&, const int& = 0);
+            void receive(const kt::ConnectionOrientedSocket&, char*, const unsigned int&, const uint64_t&, const int& = 0);
+            void send(const kt::ConnectionOrientedSocket&, const char*, const unsigned int&, const uint64_t&, const int& = 0);
+            void receiveMessage(const kt::UDPSocket&, msghdr*, const uint64_t&, const int& = 0);
+            void sendMessage(const kt::UDPSocket&, const msghdr*, const uint64_t&, const int& = 0);
+
+            int submit();
+            int submitAndWait(const unsigned int& = 1);
+            size_t drainCompletions(std::vector<kt::IOUringCompletion>&);
+
+            const char* getReceiveBuffer(const unsigned short&) const;
+            unsigned int getReceiveBufferSize() const;
+            void releaseReceiveBuffer(const unsigned short&);
+
+            kt::TCPSocket toTCPSocket(const kt::IOUringCompletion&, const kt::TCPServerSocket&) const;
+
+            void close();
+    };
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace kt
+{
+    template <typename T>
+    class Task;
+
+    namespace detail
+    {
+        /**
+         * Resumes whichever coroutine awaited the finished task, or returns to the resumer when nothing is waiting.
+         */
+        struct TaskFinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                std::coroutine_handle<> continuation = handle.promise().continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        struct TaskPromiseBase
+        {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            TaskFinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { this->exception = std::current_exception(); }
+        };
+
+        template <typename T>
+        struct TaskPromise : public TaskPromiseBase
+        {
+            std::optional<T> value;
+
+            kt::Task<T> get_return_object();
+
+            template <typename U>
+            void return_value(U&& result) { this->value.emplace(std::forward<U>(result)); }
+
+            T result()
+            {
+                if (this->exception)
+                {
+                    std::rethrow_exception(this->exception);
+                }
+                return std::move(this->value.value());
+            }
+        };
+
+        template <>
+        struct TaskPromise<void> : public TaskPromiseBase
+        {
+            kt::Task<void> get_return_object();
+
+            void return_void() const noexcept {}
+
+            void result()
+            {
+                if (this->exception)
+                {
+                    std::rethrow_exception(this->exception);
+                }
+            }
+        };
+    }
+
+    /**
+     * A lazily started coroutine producing a *T*. The coroutine body only starts running once the task is awaited, and the awaiting
+     * coroutine is resumed as soon as it finishes. Exceptions thrown by the body are rethrown from the *co_await*.
+     *
+     * Top level tasks are started with *kt::CoroutineScheduler::spawn()*.
+     */
+    template <typename T = void>
+    class Task
+    {
+        public:
+            typedef kt::detail::TaskPromise<T> promise_type;
+
+        private:
+            std::coroutine_handle<promise_type> handle;
+
+        public:
+            explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+            Task(kt::Task<T>&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+            ~Task()
+            {
+                if (this->handle)
+                {
+                    this->handle.destroy();
+                }
+            }
+
+            Task(const kt::Task<T>&) = delete;
+            kt::Task<T>& operator=(const kt::Task<T>&) = delete;
+
+            kt::Task<T>& operator=(kt::Task<T>&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    if (this->handle)
+                    {
+                        this->handle.destroy();
+                    }
+                    this->handle = std::exchange(other.handle, nullptr);
+                }
+                return *this;
+            }
+
+            bool isDone() const
+            {
+                return !this->handle || this->handle.done();
+            }
+
+            std::coroutine_handle<promise_type> release()
+            {
+                return std::exchange(this->handle, nullptr);
+            }
+
+            bool await_ready() const noexcept
+            {
+                return !this->handle || this->handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                this->handle.promise().continuation = awaiting;
+                return this->handle;
+            }
+
+            T await_resume()
+            {
+                return this->handle.promise().result();
+            }
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        kt::Task<T> TaskPromise<T>::get_return_object()
+        {
+            return kt::Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+        }
+
+        inline kt::Task<void> TaskPromise<void>::get_return_object()
+        {
+            return kt::Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+        }
+    }
+}
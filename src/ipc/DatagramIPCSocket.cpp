@@ -87,9 +87,101 @@ namespace kt
         return socketPath;
     }
 
+    /**
+     * Sets an operation that is run against each newly created send socket before it is first used.
+     * Any cached send socket is closed so that the new operation is applied to the socket used by the next send.
+     */
     void DatagramIPCSocket::setPreSendSocketOperation(std::function<void(SOCKET &)> preSendSocketOperation)
     {
         this->preSendSocketOperation = preSendSocketOperation;
+        this->closeSendSocket();
+    }
+
+    /**
+     * When enabled, *sendTo()* keeps a single send socket open for the life of this *kt::DatagramIPCSocket* and remembers the
+     * prepared address for recently used socket paths, instead of creating a socket and address for every message.
+     * The cached socket is closed by *close()* or when caching is disabled.
+     */
+    void DatagramIPCSocket::setSendSocketCaching(const bool& enabled)
+    {
+        this->cacheSendSocket = enabled;
+        if (!enabled)
+        {
+            this->closeSendSocket();
+        }
+    }
+
+    bool DatagramIPCSocket::isSendSocketCachingEnabled() const
+    {
+        return cacheSendSocket;
+    }
+
+    /**
+     * Creates a socket that is connected to the provided socket path, which is then used by *send()*.
+     * Any previously connected path is disconnected first.
+     *
+     * @return the result of the call to connect(), -1 if the connection failed or -2 if a socket could not be created.
+     */
+    int DatagramIPCSocket::connect(const std::string& path)
+    {
+        this->disconnect();
+
+        SOCKET newSocket = this->createSendSocket();
+        if (kt::isInvalidSocket(newSocket))
+        {
+            return -2;
+        }
+
+        sockaddr_un address = this->createAddress(path);
+        int result = ::connect(newSocket, (sockaddr*)&address, sizeof(address));
+        if (result != 0)
+        {
+            Socket::close(newSocket);
+            return result;
+        }
+
+        this->connectedSocket = newSocket;
+        this->connectedPath = path;
+        return result;
+    }
+
+    bool DatagramIPCSocket::isConnected() const
+    {
+        return !kt::isInvalidSocket(connectedSocket);
+    }
+
+    std::optional<std::string> DatagramIPCSocket::getConnectedPath() const
+    {
+        return connectedPath;
+    }
+
+    int DatagramIPCSocket::send(const std::string& message, const int& flags)
+    {
+        return send(message.c_str(), message.size(), flags);
+    }
+
+    /**
+     * Sends the provided buffer to the socket path provided to *connect()*.
+     *
+     * @return the result of the call to send(), or -1 if this socket is not connected.
+     */
+    int DatagramIPCSocket::send(const char* buffer, const int& bufferLength, const int& flags)
+    {
+        if (!isConnected())
+        {
+            return -1;
+        }
+        return ::send(connectedSocket, buffer, bufferLength, flags);
+    }
+
+    void DatagramIPCSocket::disconnect()
+    {
+        if (isConnected())
+        {
+            Socket::close(connectedSocket);
+        }
+        connectedSocket = kt::getInvalidSocketValue();
+        connectedPath = std::nullopt;
     }
 
     bool DatagramIPCSocket::ready(const unsigned long timeout) const
@@ -109,34 +201,36 @@ namespace kt
         return sendTo(path, message.c_str(), message.size(), flags);
     }
 
+    /**
+     * Sends the provided buffer to the provided socket path. When send socket caching is enabled the send socket and the path's
+     * address are reused between calls, otherwise a temporary socket is created and closed for this message.
+     *
+     * @return the result of the call to sendto(), or -2 if a socket could not be created.
+     */
     int DatagramIPCSocket::sendTo(const std::string &path, const char *buffer, const int &bufferLength, const int &flags)
     {
-        SOCKET tempSocket = socket(AF_UNIX, SOCK_DGRAM, 0);
+        if (cacheSendSocket)
+        {
+            if (kt::isInvalidSocket(sendSocket))
+            {
+                sendSocket = createSendSocket();
+                if (kt::isInvalidSocket(sendSocket))
+                {
+                    return -2;
+                }
+            }
+
+            const sockaddr_un& address = getCachedAddress(path);
+            return ::sendto(sendSocket, buffer, bufferLength, flags, (const sockaddr*)&address, sizeof(address));
+        }
+
+        SOCKET tempSocket = createSendSocket();
 		if (kt::isInvalidSocket(tempSocket))
 		{
 			return -2;
 		}
 
-		if (preSendSocketOperation.has_value())
-		{
-			preSendSocketOperation.value()(tempSocket);
-		}
-
-        sockaddr_un address{};
-        address.sun_family = AF_UNIX;
-
-        std::string sendPath = path;
-        if (sendPath.size() >= std::size(address.sun_path))
-        {
-            sendPath.resize(std::size(address.sun_path));
-        }
-
-#ifdef _WIN32
-        strcpy_s(address.sun_path, std::size(address.sun_path), sendPath.c_str());
-#else
-        strncpy(address.sun_path, sendPath.c_str(), std::size(address.sun_path));
-#endif
-
+        sockaddr_un address = createAddress(path);
 		int result = ::sendto(tempSocket, buffer, bufferLength, flags, (sockaddr*)&address, sizeof(address));
 		Socket::close(tempSocket);
 		return result;
@@ -175,6 +269,9 @@ namespace kt
 		return std::make_pair(flag, socketPath.value());
     }
 
+    /**
+     * Closes the receiving socket, removing its socket path, along with any cached send socket and the connected socket.
+     */
     void DatagramIPCSocket::close()
     {
         Socket::close(this->receiveSocket);
@@ -186,5 +283,63 @@ namespace kt
         }
 		socketPath = std::nullopt;
 		this->bound = false;
+
+        closeSendSocket();
+        disconnect();
+    }
+
+    sockaddr_un DatagramIPCSocket::createAddress(const std::string& path) const
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        std::string sendPath = path;
+        if (sendPath.size() >= std::size(address.sun_path))
+        {
+            sendPath.resize(std::size(address.sun_path));
+        }
+
+#ifdef _WIN32
+        strcpy_s(address.sun_path, std::size(address.sun_path), sendPath.c_str());
+#else
+        strncpy(address.sun_path, sendPath.c_str(), std::size(address.sun_path));
+#endif
+        return address;
+    }
+
+    const sockaddr_un& DatagramIPCSocket::getCachedAddress(const std::string& path)
+    {
+        auto cached = addressCache.find(path);
+        if (cached != addressCache.end())
+        {
+            return cached->second;
+        }
+
+        // Keep the cache small, senders are expected to talk to a handful of paths
+        const size_t maximumCachedAddresses = 32;
+        if (addressCache.size() >= maximumCachedAddresses)
+        {
+            addressCache.clear();
+        }
+        return addressCache.emplace(path, createAddress(path)).first->second;
+    }
+
+    SOCKET DatagramIPCSocket::createSendSocket() const
+    {
+        SOCKET newSocket = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+        if (!kt::isInvalidSocket(newSocket) && preSendSocketOperation.has_value())
+        {
+            preSendSocketOperation.value()(newSocket);
+        }
+        return newSocket;
+    }
+
+    void DatagramIPCSocket::closeSendSocket()
+    {
+        if (!kt::isInvalidSocket(sendSocket))
+        {
+            Socket::close(sendSocket);
+        }
+        sendSocket = kt::getInvalidSocketValue();
     }
 }
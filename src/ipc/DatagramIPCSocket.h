@@ -4,6 +4,8 @@
 #include "IPCSocket.h"
 #include "../socketexceptions/SocketError.h"
 
+#include <unordered_map>
+
 #ifdef _WIN32
 
 #ifndef WIN32_LEAN_AND_MEAN
@@ -40,6 +42,17 @@ namespace kt
             SOCKET receiveSocket = getInvalidSocketValue();
             std::optional<std::function<void(SOCKET&)>> preSendSocketOperation = std::nullopt;
 
+            bool cacheSendSocket = false;
+            SOCKET sendSocket = getInvalidSocketValue();
+            SOCKET connectedSocket = getInvalidSocketValue();
+            std::optional<std::string> connectedPath = std::nullopt;
+            std::unordered_map<std::string, sockaddr_un> addressCache;
+
+            sockaddr_un createAddress(const std::string&) const;
+            const sockaddr_un& getCachedAddress(const std::string&);
+            SOCKET createSendSocket() const;
+            void closeSendSocket();
+
         public:
             DatagramIPCSocket();
 
@@ -52,6 +65,15 @@ namespace kt
             std::optional<std::string> getSocketPath() const;
 
             void setPreSendSocketOperation(std::function<void(SOCKET&)>);
+            void setSendSocketCaching(const bool&);
+            bool isSendSocketCachingEnabled() const;
+
+            int connect(const std::string&);
+            bool isConnected() const;
+            std::optional<std::string> getConnectedPath() const;
+            int send(const std::string&, const int& = 0);
+            int send(const char*, const int&, const int& = 0);
+            void disconnect();
 
             bool ready(const unsigned long = 100) const override;
 
@@ -85,6 +85,20 @@ namespace kt
     }
 
     StreamIPCSocket IPCServerSocket::accept(const long &timeout) const
+    {
+        return accept(timeout, false);
+    }
+
+    /**
+     * Accepts the next incoming connection.
+     *
+     * @param timeout - The amount of microseconds to wait for a connection, 0 waits until one arrives.
+     * @param nonBlocking - When *true* the accepted socket is returned in non-blocking mode.
+     *
+     * @throw TimeoutException - If no connection arrives within the timeout.
+     * @throw SocketException - If the connection cannot be accepted.
+     */
+    StreamIPCSocket IPCServerSocket::accept(const long &timeout, const bool& nonBlocking) const
     {
         if (timeout > 0)
         {
@@ -101,15 +115,81 @@ namespace kt
 
         sockaddr_un acceptedAddress{};
         socklen_t sockLen = sizeof(acceptedAddress);
+#ifdef __linux__
+        SOCKET temp = ::accept4(this->socket, (sockaddr*)&acceptedAddress, &sockLen, nonBlocking ? SOCK_NONBLOCK : 0);
+#else
         SOCKET temp = ::accept(this->socket, (sockaddr*)&acceptedAddress, &sockLen);
+#endif
         if (isInvalidSocket(temp))
         {
             throw kt::SocketException("Failed to accept connection. Socket is in an invalid state.");
         }
 
+#ifndef __linux__
+        if (nonBlocking && !Socket::setNonBlocking(temp, true))
+        {
+            Socket::close(temp);
+            throw kt::SocketException("Failed to set accepted connection to non-blocking mode: " + getErrorCode());
+        }
+#endif
+
         return kt::StreamIPCSocket(temp, std::string(acceptedAddress.sun_path));
     }
 
+    /**
+     * Exception-free *accept()*. See *kt::TCPServerSocket::tryAccept()*.
+     *
+     * @return the accepted socket, or *Timeout*, *WouldBlock*, *InvalidSocket* or *System* if no connection was accepted.
+     */
+    kt::Result<StreamIPCSocket> IPCServerSocket::tryAccept(const long& timeout, const bool& nonBlocking) const noexcept
+    {
+        if (isInvalidSocket(this->socket))
+        {
+            return kt::Result<StreamIPCSocket>(kt::ResultError::InvalidSocket);
+        }
+
+        if (timeout > 0)
+        {
+            int res = Socket::pollSocket(this->socket, timeout);
+            if (res == -1)
+            {
+                return kt::Result<StreamIPCSocket>(kt::ResultError::InvalidSocket);
+            }
+            else if (res == 0)
+            {
+                return kt::Result<StreamIPCSocket>(kt::ResultError::Timeout);
+            }
+        }
+
+        sockaddr_un acceptedAddress{};
+        socklen_t sockLen = sizeof(acceptedAddress);
+        SOCKET temp = Socket::acceptSocket(this->socket, (sockaddr*)&acceptedAddress, &sockLen, nonBlocking, false);
+        if (isInvalidSocket(temp))
+        {
+            return kt::Result<StreamIPCSocket>(kt::isWouldBlockError() ? kt::ResultError::WouldBlock : kt::ResultError::System, kt::getLastError());
+        }
+        return kt::Result<StreamIPCSocket>(kt::StreamIPCSocket(temp, std::string(acceptedAddress.sun_path)));
+    }
+
+    /**
+     * Waits once for a connection and then accepts every connection already queued, up to *max*. The listener's mode is never
+     * changed, see *kt::TCPServerSocket::acceptMany()* for how blocking and non-blocking listeners are drained.
+     *
+     * @throw TimeoutException - If no connection arrives within the timeout.
+     * @throw SocketException - If no connection could be accepted.
+     */
+    std::vector<StreamIPCSocket> IPCServerSocket::acceptMany(const unsigned int& max, const long& timeout, const bool& nonBlocking, const bool& closeOnExec) const
+    {
+        std::vector<StreamIPCSocket> accepted;
+        this->acceptSockets(this->socket, max, timeout, nonBlocking, closeOnExec, [&accepted](const SOCKET& socket, const sockaddr_storage& address)
+        {
+            sockaddr_un acceptedAddress{};
+            std::memcpy(&acceptedAddress, &address, sizeof(acceptedAddress));
+            accepted.emplace_back(socket, std::string(acceptedAddress.sun_path));
+        });
+        return accepted;
+    }
+
     void IPCServerSocket::close()
     {
         Socket::close(socket);
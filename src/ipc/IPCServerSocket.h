@@ -3,10 +3,12 @@
 #include "../serversocket/ServerSocket.h"
 #include "StreamIPCSocket.h"
 #include "IPCSocket.h"
+#include "../socketexceptions/Result.h"
 
 #include <string>
 #include <optional>
 #include <functional>
+#include <vector>
 
 namespace kt
 {
@@ -25,10 +27,13 @@ namespace kt
             IPCServerSocket(const IPCServerSocket&);
 			IPCServerSocket& operator=(const IPCServerSocket&);
 
-            SOCKET getSocket() const;
+            SOCKET getSocket() const override;
             std::string getSocketPath() const;
 
             StreamIPCSocket accept(const long& = 0) const override;
+            StreamIPCSocket accept(const long&, const bool&) const;
+            kt::Result<StreamIPCSocket> tryAccept(const long& = 0, const bool& = false) const noexcept;
+            std::vector<StreamIPCSocket> acceptMany(const unsigned int&, const long& = 0, const bool& = false, const bool& = false) const;
 
             void close() override;
     };
@@ -2,6 +2,7 @@
 #include "../socket/Socket.h"
 #include "../socketexceptions/SocketError.h"
 #include "../socketexceptions/SocketException.hpp"
+#include "../socketexceptions/TimeoutException.hpp"
 
 #include <cstring>
 
@@ -12,6 +13,20 @@ namespace kt
         constructSocket();
     }
 
+    /**
+     * StreamIPCSocket constructor that connects to the provided path without waiting longer than the timeout, for example when the
+     * listener's backlog is full.
+     *
+     * @param timeout - The amount of microseconds to wait for the connection to be established.
+     *
+     * @throw TimeoutException - If the connection was not established within the timeout.
+     * @throw SocketException - If the connection was refused or failed.
+     */
+    StreamIPCSocket::StreamIPCSocket(const std::string& socketPath, const long& timeout) : socketPath(socketPath)
+    {
+        constructSocket(timeout);
+    }
+
     StreamIPCSocket::StreamIPCSocket(const SOCKET &socket, const std::string &socketPath) : socket(socket), socketPath(socketPath)
     {
 
@@ -47,7 +62,7 @@ namespace kt
         this->socket = getInvalidSocketValue();
     }
 
-    void StreamIPCSocket::constructSocket()
+    void StreamIPCSocket::constructSocket(const long& timeout)
     {
         sockaddr_un addr{};
         addr.sun_family = AF_UNIX;
@@ -66,11 +81,16 @@ namespace kt
         socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
         if (!isInvalidSocket(this->socket))
         {
-            int connectionResult = connect(socket, (sockaddr*)&addr, sizeof(addr));
+            int connectionResult = Socket::connectSocket(socket, (sockaddr*)&addr, sizeof(addr), timeout);
             if (connectionResult == 0)
             {
                 return;
             }
+            else if (connectionResult == 1)
+            {
+                this->close();
+                throw kt::TimeoutException("Unable to connect to provided IPC path: [" + this->socketPath + "] within " + std::to_string(timeout) + " microseconds.");
+            }
         }
 
         throw kt::SocketException("Unable to connect to provided IPC path: [" + this->socketPath + "] " + getErrorCode());
@@ -39,10 +39,11 @@ namespace kt
             SOCKET socket;
             std::string socketPath;
 
-            void constructSocket();
+            void constructSocket(const long& = 0);
         public:
             StreamIPCSocket() = delete;
             StreamIPCSocket(const std::string&);
+            StreamIPCSocket(const std::string&, const long&);
             StreamIPCSocket(const SOCKET&, const std::string&);
 
             StreamIPCSocket(const StreamIPCSocket&);
@@ -0,0 +1,350 @@
+#include "TCPConnectionPool.h"
+
+#include "../socketexceptions/SocketException.hpp"
+#include "../socketexceptions/TimeoutException.hpp"
+#include "../socketexceptions/SocketError.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _WIN32
+
+#include <WinSock2.h>
+
+#else
+
+#include <sys/socket.h>
+
+#endif
+
+namespace kt
+{
+    /**
+     * TCPConnectionPool constructor. No connections are made until a socket is leased or *warmUp()* is called.
+     *
+     * @param maxTotal - The most connections kept open to a single host and port, including leased ones. 0 is treated as 1.
+     * @param minIdle - The amount of idle connections *warmUp()* and *maintain()* keep ready for each host and port.
+     * @param connectTimeout - The amount of microseconds a new connection may take, 0 uses a blocking connect.
+     * @param maxIdleTime - The amount of microseconds a connection may stay idle before it is closed instead of reused, 0 never expires them.
+     * @param protocolVersion - The IP version used when resolving the hostnames.
+     */
+    TCPConnectionPool::TCPConnectionPool(const unsigned int& maxTotal, const unsigned int& minIdle, const long& connectTimeout, const long& maxIdleTime, const kt::InternetProtocolVersion protocolVersion)
+        : maxTotal(maxTotal == 0 ? 1 : maxTotal), minIdle(minIdle), connectTimeout(connectTimeout), maxIdleTime(maxIdleTime), protocolVersion(protocolVersion) {}
+
+    std::string TCPConnectionPool::getKey(const std::string& hostname, const unsigned short& port) const
+    {
+        return hostname + ":" + std::to_string(port);
+    }
+
+    TCPConnectionPool::Endpoint& TCPConnectionPool::getEndpoint(const std::string& hostname, const unsigned short& port)
+    {
+        Endpoint& endpoint = this->endpoints[this->getKey(hostname, port)];
+        if (endpoint.hostname.empty())
+        {
+            endpoint.hostname = hostname;
+            endpoint.port = port;
+        }
+        return endpoint;
+    }
+
+    /**
+     * Opens a new connection with keep-alive enabled, so connections sitting idle in the pool are probed by the OS as well.
+     */
+    kt::TCPSocket TCPConnectionPool::connect(const std::string& hostname, const unsigned short& port) const
+    {
+        kt::TCPSocket socket = this->connectTimeout > 0
+            ? kt::TCPSocket(hostname, port, this->protocolVersion, this->connectTimeout)
+            : kt::TCPSocket(hostname, port, this->protocolVersion);
+
+        const int enabled = 1;
+        setsockopt(socket.getSocket(), SOL_SOCKET, SO_KEEPALIVE, reinterpret_cast<const char*>(&enabled), sizeof(enabled));
+        return socket;
+    }
+
+    /**
+     * Checks an idle connection without blocking. Nothing should arrive on a connection nobody is using, so any readable state means
+     * the peer closed it or left data behind that would be mistaken for the next response.
+     */
+    bool TCPConnectionPool::isReusable(const IdleConnection& connection) const
+    {
+        if (this->maxIdleTime > 0 && std::chrono::steady_clock::now() - connection.since > std::chrono::microseconds(this->maxIdleTime))
+        {
+            return false;
+        }
+
+#ifdef __linux__
+        char peeked;
+        const int result = ::recv(connection.socket.getSocket(), &peeked, 1, MSG_PEEK | MSG_DONTWAIT);
+        return result == -1 && kt::isWouldBlockError();
+#else
+        return connection.socket.connected(0) && !connection.socket.ready(0);
+#endif
+    }
+
+    /**
+     * Closes every idle connection of the endpoint that can no longer be handed out.
+     */
+    void TCPConnectionPool::evict(Endpoint& endpoint)
+    {
+        for (auto it = endpoint.idle.begin(); it != endpoint.idle.end();)
+        {
+            if (this->isReusable(*it))
+            {
+                ++it;
+                continue;
+            }
+            it->socket.close();
+            it = endpoint.idle.erase(it);
+            endpoint.total--;
+        }
+    }
+
+    /**
+     * Opens connections until the endpoint has *minIdle* idle ones or reaches *maxTotal*. The lock is released while connecting.
+     */
+    size_t TCPConnectionPool::topUp(Endpoint& endpoint, std::unique_lock<std::mutex>& lock)
+    {
+        this->evict(endpoint);
+        size_t needed = 0;
+        if (endpoint.idle.size() < this->minIdle && endpoint.total < this->maxTotal)
+        {
+            needed = std::min(this->minIdle - endpoint.idle.size(), this->maxTotal - endpoint.total);
+        }
+        // Reserve the slots up front so concurrent leases cannot exceed maxTotal while we connect
+        endpoint.total += needed;
+
+        const std::string hostname = endpoint.hostname;
+        const unsigned short port = endpoint.port;
+        std::vector<kt::TCPSocket> opened;
+        lock.unlock();
+        for (size_t i = 0; i < needed; i++)
+        {
+            try
+            {
+                opened.push_back(this->connect(hostname, port));
+            }
+            catch (const kt::SocketException&)
+            {
+                break;
+            }
+        }
+        lock.lock();
+
+        // The endpoint reference stays valid, unordered_map never moves its elements and endpoints are never erased
+        endpoint.total -= needed - opened.size();
+        for (kt::TCPSocket& socket : opened)
+        {
+            if (this->closed)
+            {
+                socket.close();
+                endpoint.total--;
+                continue;
+            }
+            endpoint.idle.push_back(IdleConnection{ socket, std::chrono::steady_clock::now() });
+        }
+        endpoint.available.notify_all();
+        return this->closed ? 0 : opened.size();
+    }
+
+    /**
+     * Takes a connection to the host and port out of the pool. The most recently used idle connection is preferred, otherwise a new one
+     * is opened if the endpoint is below its limit, otherwise this waits for another caller to release or discard theirs.
+     *
+     * @param timeout - The amount of microseconds to wait for a connection when the endpoint is at its limit, 0 waits indefinitely.
+     *
+     * @return a connected socket that must be passed to *release()* or *discard()* once the caller is done with it.
+     *
+     * @throw TimeoutException - If no connection became available within the timeout.
+     * @throw SocketException - If a new connection cannot be made, or the pool has been closed.
+     */
+    kt::TCPSocket TCPConnectionPool::lease(const std::string& hostname, const unsigned short& port, const long& timeout)
+    {
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+        std::unique_lock<std::mutex> lock(this->mutex);
+        Endpoint& endpoint = this->getEndpoint(hostname, port);
+        const std::string key = this->getKey(hostname, port);
+
+        while (true)
+        {
+            if (this->closed)
+            {
+                throw kt::SocketException("Unable to lease a connection to " + key + " from a closed pool.");
+            }
+
+            while (!endpoint.idle.empty())
+            {
+                IdleConnection connection = endpoint.idle.back();
+                endpoint.idle.pop_back();
+                if (this->isReusable(connection))
+                {
+                    this->leased[connection.socket.getSocket()] = key;
+                    return connection.socket;
+                }
+                connection.socket.close();
+                endpoint.total--;
+            }
+
+            if (endpoint.total < this->maxTotal)
+            {
+                endpoint.total++;
+                lock.unlock();
+                try
+                {
+                    kt::TCPSocket socket = this->connect(hostname, port);
+                    lock.lock();
+                    this->leased[socket.getSocket()] = key;
+                    return socket;
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    endpoint.total--;
+                    endpoint.available.notify_one();
+                    throw;
+                }
+            }
+
+            if (timeout <= 0)
+            {
+                endpoint.available.wait(lock);
+            }
+            else if (endpoint.available.wait_until(lock, deadline) == std::cv_status::timeout)
+            {
+                throw kt::TimeoutException("Timed out waiting for a connection to " + key + ", " + std::to_string(endpoint.total) + " are in use.");
+            }
+        }
+    }
+
+    /**
+     * Returns a leased connection to the pool so it can be handed to the next caller. Only release a connection once every response
+     * to the requests sent on it has been fully received, otherwise it is closed by the next *lease()*.
+     *
+     * @return *false* if the socket was not leased from this pool, in which case it is left untouched.
+     */
+    bool TCPConnectionPool::release(const kt::TCPSocket& socket)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto leasedSocket = this->leased.find(socket.getSocket());
+        if (leasedSocket == this->leased.end())
+        {
+            return false;
+        }
+
+        Endpoint& endpoint = this->endpoints[leasedSocket->second];
+        this->leased.erase(leasedSocket);
+        if (this->closed)
+        {
+            kt::TCPSocket closing = socket;
+            closing.close();
+            endpoint.total--;
+        }
+        else
+        {
+            endpoint.idle.push_back(IdleConnection{ socket, std::chrono::steady_clock::now() });
+        }
+        endpoint.available.notify_one();
+        return true;
+    }
+
+    /**
+     * Closes a leased connection and frees its slot, for connections that failed or were left in an unknown state.
+     *
+     * @return *false* if the socket was not leased from this pool, in which case it is left untouched.
+     */
+    bool TCPConnectionPool::discard(const kt::TCPSocket& socket)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto leasedSocket = this->leased.find(socket.getSocket());
+        if (leasedSocket == this->leased.end())
+        {
+            return false;
+        }
+
+        Endpoint& endpoint = this->endpoints[leasedSocket->second];
+        endpoint.total--;
+        this->leased.erase(leasedSocket);
+        kt::TCPSocket closing = socket;
+        closing.close();
+        endpoint.available.notify_one();
+        return true;
+    }
+
+    /**
+     * Opens connections to the host and port until *minIdle* of them are idle, so the first leases do not pay for the handshake.
+     * Connection failures are not thrown, the amount opened is returned instead.
+     *
+     * @return the amount of connections opened.
+     */
+    size_t TCPConnectionPool::warmUp(const std::string& hostname, const unsigned short& port)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if (this->closed)
+        {
+            return 0;
+        }
+        return this->topUp(this->getEndpoint(hostname, port), lock);
+    }
+
+    /**
+     * Closes the idle connections that are no longer usable and tops every known endpoint back up to *minIdle*.
+     * Intended to be called periodically, for example from a timer thread.
+     *
+     * @return the amount of connections opened.
+     */
+    size_t TCPConnectionPool::maintain()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        std::vector<std::string> keys;
+        for (const std::pair<const std::string, Endpoint>& endpoint : this->endpoints)
+        {
+            keys.push_back(endpoint.first);
+        }
+
+        size_t opened = 0;
+        for (const std::string& key : keys)
+        {
+            if (this->closed)
+            {
+                break;
+            }
+            opened += this->topUp(this->endpoints[key], lock);
+        }
+        return opened;
+    }
+
+    size_t TCPConnectionPool::getIdleCount(const std::string& hostname, const unsigned short& port) const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto endpoint = this->endpoints.find(this->getKey(hostname, port));
+        return endpoint == this->endpoints.end() ? 0 : endpoint->second.idle.size();
+    }
+
+    /**
+     * @return the amount of connections to the host and port, including leased ones and ones currently connecting.
+     */
+    size_t TCPConnectionPool::getTotalCount(const std::string& hostname, const unsigned short& port) const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto endpoint = this->endpoints.find(this->getKey(hostname, port));
+        return endpoint == this->endpoints.end() ? 0 : endpoint->second.total;
+    }
+
+    /**
+     * Closes every idle connection and fails any further *lease()*. Leased connections are closed as they are released.
+     */
+    void TCPConnectionPool::close()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closed = true;
+        for (std::pair<const std::string, Endpoint>& endpoint : this->endpoints)
+        {
+            for (IdleConnection& connection : endpoint.second.idle)
+            {
+                connection.socket.close();
+            }
+            endpoint.second.total -= endpoint.second.idle.size();
+            endpoint.second.idle.clear();
+            endpoint.second.available.notify_all();
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../socket/TCPSocket.h"
+#include "../enums/InternetProtocolVersion.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace kt
+{
+    /**
+     * Keeps connected *kt::TCPSocket*s per remote host and port so they can be reused instead of connecting for every request.
+     *
+     * A socket is taken from the pool with *lease()* and handed back with *release()* once the caller has finished its exchange, or
+     * with *discard()* if the connection should not be used again. Idle connections are checked before they are handed out, so a
+     * connection the peer has closed, or one with unread data left on it, is replaced rather than returned.
+     *
+     * Every method may be called from any thread. A leased socket is only handed to one caller at a time.
+     */
+    class TCPConnectionPool
+    {
+        private:
+            struct IdleConnection
+            {
+                kt::TCPSocket socket;
+                std::chrono::steady_clock::time_point since;
+            };
+
+            struct Endpoint
+            {
+                std::string hostname;
+                unsigned short port = 0;
+                std::deque<IdleConnection> idle;
+                // Idle, leased and currently connecting sockets
+                size_t total = 0;
+                // One per endpoint, so a freed slot only wakes the callers waiting on this endpoint
+                std::condition_variable available;
+            };
+
+            unsigned int maxTotal;
+            unsigned int minIdle;
+            long connectTimeout;
+            long maxIdleTime;
+            kt::InternetProtocolVersion protocolVersion;
+
+            mutable std::mutex mutex;
+            std::unordered_map<std::string, Endpoint> endpoints;
+            std::unordered_map<SOCKET, std::string> leased;
+            bool closed = false;
+
+            std::string getKey(const std::string&, const unsigned short&) const;
+            Endpoint& getEndpoint(const std::string&, const unsigned short&);
+            kt::TCPSocket connect(const std::string&, const unsigned short&) const;
+            bool isReusable(const IdleConnection&) const;
+            void evict(Endpoint&);
+            size_t topUp(Endpoint&, std::unique_lock<std::mutex>&);
+
+        public:
+            TCPConnectionPool(const unsigned int& = 8, const unsigned int& = 0, const long& = 0, const long& = 0, const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any);
+
+            TCPConnectionPool(const kt::TCPConnectionPool&) = delete;
+            kt::TCPConnectionPool& operator=(const kt::TCPConnectionPool&) = delete;
+
+            kt::TCPSocket lease(const std::string&, const unsigned short&, const long& = 0);
+            bool release(const kt::TCPSocket&);
+            bool discard(const kt::TCPSocket&);
+
+            size_t warmUp(const std::string&, const unsigned short&);
+            size_t maintain();
+
+            size_t getIdleCount(const std::string&, const unsigned short&) const;
+            size_t getTotalCount(const std::string&, const unsigned short&) const;
+
+            void close();
+    };
+}
@@ -0,0 +1,396 @@
+#include "TCPServer.h"
+
+#include "../socketexceptions/SocketException.hpp"
+
+#include <cerrno>
+
+namespace kt
+{
+    namespace
+    {
+        // How many queued notifications a worker handles before collecting new ones from its loop
+        const size_t NOTIFICATIONS_PER_POLL = 32;
+        // Upper bound on how long an idle worker sleeps before looking for work to steal again
+        const long IDLE_POLL_TIMEOUT = 50000;
+        // How long the listener is left unpolled after accepting failed for a reason that does not clear by itself
+        const long ACCEPT_BACKOFF = 100000;
+
+        /**
+         * @return *true* for accept errors that only affect the connection being accepted, after which the next accept can succeed.
+         */
+        bool isTransientAcceptError(const int& error)
+        {
+            return error == ECONNABORTED || error == EAGAIN || error == EWOULDBLOCK || error == EINTR || error == EPROTO;
+        }
+    }
+
+    /**
+     * TCPServer constructor. The workers are created immediately but nothing is accepted until *start()* is called.
+     *
+     * @param serverSocket - The listening socket to accept connections from. It is not closed by the server.
+     * @param handler - Invoked on a worker thread whenever a connection is ready, see *kt::TCPServer*.
+     * @param workerCount - The amount of worker threads, 0 is treated as 1.
+     *
+     * @throw SocketException - If the event loops cannot be created, or when not running on Linux.
+     */
+    TCPServer::TCPServer(const kt::TCPServerSocket& serverSocket, const Handler& handler, const unsigned int& workerCount) : serverSocket(serverSocket), handler(handler)
+    {
+        const unsigned int count = workerCount == 0 ? 1 : workerCount;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            this->workers.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    TCPServer::~TCPServer()
+    {
+        this->stop();
+    }
+
+    /**
+     * Starts the accept thread and the worker threads. Does nothing if the server is already running.
+     */
+    void TCPServer::start()
+    {
+        if (this->running.exchange(true))
+        {
+            return;
+        }
+
+        this->acceptPaused = false;
+        this->listen();
+
+        for (size_t i = 0; i < this->workers.size(); i++)
+        {
+            this->workers[i]->thread = std::thread(&TCPServer::work, this, i);
+        }
+        this->acceptThread = std::thread([this]()
+        {
+            while (this->running)
+            {
+                this->acceptLoop.poll(this->pollAcceptLoop());
+            }
+        });
+    }
+
+    /**
+     * Stops accepting, waits for the worker threads to finish their current handler and closes every open connection.
+     * Queued notifications that were not yet handled are discarded. The server can be started again afterwards.
+     */
+    void TCPServer::stop()
+    {
+        if (!this->running.exchange(false))
+        {
+            return;
+        }
+
+        this->acceptLoop.wakeUp();
+        this->acceptThread.join();
+        this->acceptLoop.remove(this->serverSocket.getSocket());
+
+        for (std::unique_ptr<Worker>& worker : this->workers)
+        {
+            worker->loop.wakeUp();
+        }
+        for (std::unique_ptr<Worker>& worker : this->workers)
+        {
+            worker->thread.join();
+
+            std::lock_guard<std::mutex> lock(worker->connectionMutex);
+            for (std::pair<const SOCKET, std::shared_ptr<Connection>>& connection : worker->connections)
+            {
+                worker->loop.remove(connection.first);
+                connection.second->socket.close();
+            }
+            worker->connections.clear();
+            worker->queue.clear();
+        }
+    }
+
+    bool TCPServer::isRunning() const
+    {
+        return this->running;
+    }
+
+    void TCPServer::listen()
+    {
+        this->acceptLoop.add(this->serverSocket, kt::SocketEvent::Read, [this](SOCKET, kt::SocketEvent)
+        {
+            this->acceptConnections();
+        });
+    }
+
+    /**
+     * Registers the listener again once its back off has passed.
+     *
+     * @return how long the accept loop may wait for events, in microseconds, or -1 to wait until woken up.
+     */
+    long TCPServer::pollAcceptLoop()
+    {
+        if (!this->acceptPaused)
+        {
+            return -1;
+        }
+
+        const std::chrono::steady_clock::duration remaining = this->acceptResumeTime - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero())
+        {
+            this->acceptPaused = false;
+            this->listen();
+            return -1;
+        }
+        return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(remaining).count()) + 1;
+    }
+
+    void TCPServer::acceptConnections()
+    {
+        kt::Result<kt::TCPSocket> accepted = this->serverSocket.tryAccept(0, true);
+        if (accepted)
+        {
+            this->assign(accepted.value());
+            return;
+        }
+
+        // The connection was aborted before it could be accepted, the loop will notify again for any others
+        if (accepted.getError() == kt::ResultError::WouldBlock || (accepted.getError() == kt::ResultError::System && isTransientAcceptError(accepted.getCode())))
+        {
+            return;
+        }
+
+        // Failures such as EMFILE and ENFILE leave the connection queued, so the level triggered listener would be reported ready
+        // again immediately and the accept thread would spin until a descriptor is freed
+        this->acceptLoop.remove(this->serverSocket.getSocket());
+        this->acceptPaused = true;
+        this->acceptResumeTime = std::chrono::steady_clock::now() + std::chrono::microseconds(ACCEPT_BACKOFF);
+    }
+
+    /**
+     * Hands the accepted connection to the next worker in turn. Imbalance between workers is evened out by stealing rather than here.
+     */
+    void TCPServer::assign(const kt::TCPSocket& socket)
+    {
+        const size_t owner = this->nextWorker++ % this->workers.size();
+        Worker& worker = *this->workers[owner];
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(socket, owner);
+        {
+            std::lock_guard<std::mutex> lock(worker.connectionMutex);
+            worker.connections[socket.getSocket()] = connection;
+        }
+
+        try
+        {
+            worker.loop.add(socket.getSocket(), kt::SocketEvent::Read | kt::SocketEvent::OneShot, [this, owner, connection](SOCKET, kt::SocketEvent events)
+            {
+                this->enqueue(owner, Notification{ connection, events });
+            });
+        }
+        catch (const kt::SocketException&)
+        {
+            // The worker's loop could not take the connection, so it is dropped rather than left open and never served
+            this->closeConnection(connection);
+        }
+    }
+
+    void TCPServer::work(const size_t& index)
+    {
+        Worker& worker = *this->workers[index];
+        size_t dispatched = 0;
+        Notification notification;
+        while (this->running)
+        {
+            if (this->dequeue(index, notification))
+            {
+                this->run(index, notification);
+                if (++dispatched % NOTIFICATIONS_PER_POLL == 0)
+                {
+                    // Collect connections that became ready meanwhile so they are queued where other workers can steal them
+                    this->pollOwn(index, 0);
+                }
+                continue;
+            }
+
+            if (this->pollOwn(index, 0) > 0)
+            {
+                continue;
+            }
+
+            if (this->steal(index, notification))
+            {
+                this->run(index, notification);
+                continue;
+            }
+
+            if (this->pollBusy(index))
+            {
+                continue;
+            }
+
+            worker.idle = true;
+            this->pollOwn(index, IDLE_POLL_TIMEOUT);
+            worker.idle = false;
+        }
+    }
+
+    /**
+     * Runs the handler for a notification on the provided worker, marking it busy so idle workers poll its loop meanwhile.
+     */
+    void TCPServer::run(const size_t& index, const Notification& notification)
+    {
+        Worker& worker = *this->workers[index];
+        worker.busy = true;
+        this->dispatch(notification);
+        worker.busy = false;
+    }
+
+    int TCPServer::pollOwn(const size_t& index, const long& timeout)
+    {
+        Worker& worker = *this->workers[index];
+        std::lock_guard<std::mutex> lock(worker.pollMutex);
+        return worker.loop.poll(timeout);
+    }
+
+    /**
+     * Polls the loop of each worker that is busy running a handler, so that connections which became ready behind the handler are
+     * queued on their owner and can be stolen. A loop that is already being polled is skipped.
+     *
+     * @return *true* if any notifications were queued.
+     */
+    bool TCPServer::pollBusy(const size_t& index)
+    {
+        bool queued = false;
+        for (size_t offset = 1; offset < this->workers.size(); offset++)
+        {
+            Worker& victim = *this->workers[(index + offset) % this->workers.size()];
+            if (!victim.busy)
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(victim.pollMutex, std::try_to_lock);
+            if (lock.owns_lock() && victim.loop.poll(0) > 0)
+            {
+                queued = true;
+            }
+        }
+        return queued;
+    }
+
+    void TCPServer::enqueue(const size_t& index, const Notification& notification)
+    {
+        size_t queued = 0;
+        {
+            Worker& worker = *this->workers[index];
+            std::lock_guard<std::mutex> lock(worker.queueMutex);
+            worker.queue.push_back(notification);
+            queued = worker.queue.size();
+        }
+
+        // The owner can only handle one notification at a time, so anything more is offered to a sleeping worker
+        if (queued > 1)
+        {
+            for (std::unique_ptr<Worker>& worker : this->workers)
+            {
+                if (worker->idle)
+                {
+                    worker->loop.wakeUp();
+                    break;
+                }
+            }
+        }
+    }
+
+    bool TCPServer::dequeue(const size_t& index, Notification& notification)
+    {
+        Worker& worker = *this->workers[index];
+        std::lock_guard<std::mutex> lock(worker.queueMutex);
+        if (worker.queue.empty())
+        {
+            return false;
+        }
+        notification = std::move(worker.queue.front());
+        worker.queue.pop_front();
+        return true;
+    }
+
+    /**
+     * Takes the most recently queued notification from another worker. The owner handles its queue from the front, so thieves
+     * taking from the back rarely contend with it.
+     */
+    bool TCPServer::steal(const size_t& index, Notification& notification)
+    {
+        for (size_t offset = 1; offset < this->workers.size(); offset++)
+        {
+            Worker& victim = *this->workers[(index + offset) % this->workers.size()];
+            std::unique_lock<std::mutex> lock(victim.queueMutex, std::try_to_lock);
+            if (lock.owns_lock() && !victim.queue.empty())
+            {
+                notification = std::move(victim.queue.back());
+                victim.queue.pop_back();
+                this->stolenNotifications++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Runs the handler for a notification and re-arms the connection for the events it asked for, or closes it.
+     * An exception thrown by the handler closes the connection.
+     */
+    void TCPServer::dispatch(const Notification& notification)
+    {
+        const std::shared_ptr<Connection>& connection = notification.connection;
+        kt::SocketEvent next = kt::SocketEvent::None;
+        try
+        {
+            next = this->handler(connection->socket, notification.events) & (kt::SocketEvent::Read | kt::SocketEvent::Write);
+        }
+        catch (...)
+        {
+            next = kt::SocketEvent::None;
+        }
+
+        if (next == kt::SocketEvent::None || kt::hasEvent(notification.events, kt::SocketEvent::Closed | kt::SocketEvent::Error))
+        {
+            this->closeConnection(connection);
+            return;
+        }
+        this->workers[connection->owner]->loop.modify(connection->socket.getSocket(), next | kt::SocketEvent::OneShot);
+    }
+
+    void TCPServer::closeConnection(const std::shared_ptr<Connection>& connection)
+    {
+        Worker& owner = *this->workers[connection->owner];
+        const SOCKET socket = connection->socket.getSocket();
+        owner.loop.remove(socket);
+        {
+            std::lock_guard<std::mutex> lock(owner.connectionMutex);
+            owner.connections.erase(socket);
+        }
+        connection->socket.close();
+    }
+
+    size_t TCPServer::getWorkerCount() const
+    {
+        return this->workers.size();
+    }
+
+    size_t TCPServer::getConnectionCount() const
+    {
+        size_t count = 0;
+        for (const std::unique_ptr<Worker>& worker : this->workers)
+        {
+            std::lock_guard<std::mutex> lock(worker->connectionMutex);
+            count += worker->connections.size();
+        }
+        return count;
+    }
+
+    /**
+     * @return the amount of notifications that were handled by a worker other than the connection's owner.
+     */
+    size_t TCPServer::getStolenNotificationCount() const
+    {
+        return this->stolenNotifications;
+    }
+}
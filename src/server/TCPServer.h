@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../eventloop/EventLoop.h"
+#include "../serversocket/TCPServerSocket.h"
+#include "../socket/TCPSocket.h"
+#include "../enums/SocketEvent.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace kt
+{
+    /**
+     * Runs an accept loop for a *kt::TCPServerSocket* and serves the accepted connections from a pool of worker threads.
+     *
+     * Each worker owns a *kt::EventLoop* for the connections assigned to it. Readiness notifications are queued on the owning worker,
+     * and idle workers steal queued notifications from busy ones, so a few hot connections do not leave the other workers idle.
+     * While a worker is running a handler nothing polls its loop, so idle workers also poll the loops of busy workers on their behalf,
+     * queueing the owner's ready connections where they can be stolen.
+     * Connections are registered as one-shot, so the handler is never run concurrently for the same connection.
+     *
+     * The handler is given the connection and the events that occurred, and returns the events it wants to wait for next.
+     * Returning *kt::SocketEvent::None* closes the connection. After a *Closed* or *Error* notification the connection is closed
+     * once the handler returns, regardless of the returned events.
+     *
+     * Accepted connections are in non-blocking mode, see *kt::ConnectionOrientedSocket::receivePartial()* and *sendPartial()*.
+     * If accepting fails for a reason that does not clear by itself, such as running out of file descriptors, the listener is left
+     * unpolled for a short time instead of being retried straight away.
+     *
+     * **TCPServer is only supported on Linux**
+     */
+    class TCPServer
+    {
+        public:
+            typedef std::function<kt::SocketEvent(kt::TCPSocket&, kt::SocketEvent)> Handler;
+
+        private:
+            struct Connection
+            {
+                kt::TCPSocket socket;
+                size_t owner;
+
+                Connection(const kt::TCPSocket& socket, const size_t& owner) : socket(socket), owner(owner) {}
+            };
+
+            struct Notification
+            {
+                std::shared_ptr<Connection> connection;
+                kt::SocketEvent events;
+            };
+
+            struct Worker
+            {
+                kt::EventLoop loop;
+                std::thread thread;
+                std::atomic<bool> idle{false};
+                std::atomic<bool> busy{false};
+
+                // Held while polling the loop, which is shared by the owner and any idle worker polling on its behalf
+                std::mutex pollMutex;
+
+                std::mutex queueMutex;
+                std::deque<Notification> queue;
+
+                std::mutex connectionMutex;
+                std::unordered_map<SOCKET, std::shared_ptr<Connection>> connections;
+            };
+
+            kt::TCPServerSocket serverSocket;
+            Handler handler;
+            kt::EventLoop acceptLoop;
+            std::thread acceptThread;
+            // Only used by the accept thread, set while the listener is left out of the accept loop after a persistent failure
+            bool acceptPaused = false;
+            std::chrono::steady_clock::time_point acceptResumeTime;
+            std::vector<std::unique_ptr<Worker>> workers;
+            size_t nextWorker = 0;
+            std::atomic<bool> running{false};
+            std::atomic<size_t> stolenNotifications{0};
+
+            void listen();
+            void acceptConnections();
+            long pollAcceptLoop();
+            void assign(const kt::TCPSocket&);
+            void work(const size_t&);
+            void enqueue(const size_t&, const Notification&);
+            bool dequeue(const size_t&, Notification&);
+            bool steal(const size_t&, Notification&);
+            int pollOwn(const size_t&, const long&);
+            bool pollBusy(const size_t&);
+            void run(const size_t&, const Notification&);
+            void dispatch(const Notification&);
+            void closeConnection(const std::shared_ptr<Connection>&);
+
+        public:
+            TCPServer(const kt::TCPServerSocket&, const Handler&, const unsigned int& = std::thread::hardware_concurrency());
+            ~TCPServer();
+
+            TCPServer(const kt::TCPServer&) = delete;
+            kt::TCPServer& operator=(const kt::TCPServer&) = delete;
+
+            void start();
+            void stop();
+            bool isRunning() const;
+
+            size_t getWorkerCount() const;
+            size_t getConnectionCount() const;
+            size_t getStolenNotificationCount() const;
+    };
+}
@@ -8,6 +8,7 @@ namespace kt
 	class ServerSocket : public Socket
 	{
 		public:
+			virtual SOCKET getSocket() const = 0;
 			virtual T accept(const long& = 0) const = 0;
 	};
 }
@@ -0,0 +1,144 @@
+#include "ShardedTCPServerSocket.h"
+#include "../socketexceptions/SocketException.hpp"
+#include "../socketexceptions/SocketError.h"
+
+#include <string>
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+
+#endif
+
+namespace kt
+{
+    /**
+     * ShardedTCPServerSocket constructor. Creates the requested amount of listening sockets on the same address and port.
+     *
+     * @param shardCount - The amount of listening sockets to create, usually one per accepting thread or core.
+     * @param port - The port number to listen on. If value is not passed in a random, available port number is assigned and shared by every shard.
+     * @param connectionBacklogSize - The length of the connection pool of each shard. The default value is 20.
+     * @param preBindSocketOperation - Invoked for every shard after *SO_REUSEPORT* has been set and before it is bound.
+     *
+     * @throw SocketException - If a shard cannot be created, if *shardCount* is 0, or if more than one shard is requested on a platform
+     * without SO_REUSEPORT.
+     * @throw BindingException - If a shard is unable to bind to the port, for example when it is used by a listener without SO_REUSEPORT.
+     */
+    ShardedTCPServerSocket::ShardedTCPServerSocket(const unsigned int& shardCount, const std::optional<std::string>& localHostname, const unsigned short& port, const unsigned int& connectionBacklogSize, const kt::InternetProtocolVersion protocolVersion, const std::optional<std::function<void(SOCKET&)>>& preBindSocketOperation)
+    {
+        if (shardCount == 0)
+        {
+            throw kt::SocketException("A ShardedTCPServerSocket requires at least one shard.");
+        }
+
+#ifndef SO_REUSEPORT
+        if (shardCount > 1)
+        {
+            throw kt::SocketException("SO_REUSEPORT is not supported on this platform, so only a single shard can be created.");
+        }
+#endif
+
+        const std::function<void(SOCKET&)> shardOperation = [&preBindSocketOperation](SOCKET& socket)
+        {
+#ifdef SO_REUSEPORT
+            const int enableOption = 1;
+            if (setsockopt(socket, SOL_SOCKET, SO_REUSEPORT, (const char*)&enableOption, sizeof(enableOption)) != 0)
+            {
+                throw kt::SocketException("Failed to set SO_REUSEPORT socket option: " + getErrorCode());
+            }
+#endif
+            if (preBindSocketOperation.has_value())
+            {
+                preBindSocketOperation.value()(socket);
+            }
+        };
+
+        this->shards.reserve(shardCount);
+        try
+        {
+            // The first shard resolves the address and picks the port when none was provided, the rest join it
+            this->shards.emplace_back(localHostname, port, connectionBacklogSize, protocolVersion, shardOperation);
+            for (unsigned int i = 1; i < shardCount; i++)
+            {
+                this->shards.emplace_back(localHostname, this->shards.front().getPort(), connectionBacklogSize, this->shards.front().getInternetProtocolVersion(), shardOperation);
+            }
+        }
+        catch (...)
+        {
+            this->close();
+            throw;
+        }
+    }
+
+    size_t ShardedTCPServerSocket::getShardCount() const
+    {
+        return this->shards.size();
+    }
+
+    /**
+     * @throw std::out_of_range - If the index is not less than *getShardCount()*.
+     */
+    kt::TCPServerSocket& ShardedTCPServerSocket::getShard(const size_t& index)
+    {
+        return this->shards.at(index);
+    }
+
+    const kt::TCPServerSocket& ShardedTCPServerSocket::getShard(const size_t& index) const
+    {
+        return this->shards.at(index);
+    }
+
+    /**
+     * Accepts the next connection queued on the provided shard. See *kt::TCPServerSocket::accept()*.
+     *
+     * @throw std::out_of_range - If the index is not less than *getShardCount()*.
+     */
+    kt::TCPSocket ShardedTCPServerSocket::accept(const size_t& index, const long& timeout) const
+    {
+        return this->shards.at(index).accept(timeout);
+    }
+
+    kt::InternetProtocolVersion ShardedTCPServerSocket::getInternetProtocolVersion() const
+    {
+        return this->shards.front().getInternetProtocolVersion();
+    }
+
+    /**
+     * @return the port shared by every shard.
+     */
+    unsigned short ShardedTCPServerSocket::getPort() const
+    {
+        return this->shards.front().getPort();
+    }
+
+    kt::SocketAddress ShardedTCPServerSocket::getSocketAddress() const
+    {
+        return this->shards.front().getSocketAddress();
+    }
+
+    /**
+     * @return the listening descriptor of each shard, in shard order. Useful for registering every shard with a *kt::EventLoop*.
+     */
+    std::vector<SOCKET> ShardedTCPServerSocket::getSockets() const
+    {
+        std::vector<SOCKET> sockets;
+        sockets.reserve(this->shards.size());
+        for (const kt::TCPServerSocket& shard : this->shards)
+        {
+            sockets.push_back(shard.getSocket());
+        }
+        return sockets;
+    }
+
+    /**
+     * Closes every shard. Connections still queued on a shard are reset by the kernel rather than moved to another shard.
+     */
+    void ShardedTCPServerSocket::close()
+    {
+        for (kt::TCPServerSocket& shard : this->shards)
+        {
+            shard.close();
+        }
+    }
+
+} // End namespace kt
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <optional>
+#include <functional>
+#include <vector>
+
+#include "TCPServerSocket.h"
+#include "../address/SocketAddress.h"
+#include "../socket/TCPSocket.h"
+#include "../enums/InternetProtocolVersion.h"
+
+namespace kt
+{
+	/**
+	 * A group of *kt::TCPServerSocket* listeners bound to the same address and port with *SO_REUSEPORT*. The kernel spreads incoming
+	 * connections across the shards, so each worker thread can accept from its own shard without contending on a single accept queue.
+	 *
+	 * **More than one shard is only supported on platforms providing SO_REUSEPORT**
+	 */
+	class ShardedTCPServerSocket
+	{
+		protected:
+			std::vector<kt::TCPServerSocket> shards;
+
+		public:
+			ShardedTCPServerSocket(const unsigned int&, const std::optional<std::string>& = std::nullopt, const unsigned short& = 0, const unsigned int& = 20, const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any, const std::optional<std::function<void(SOCKET&)>>& = std::nullopt);
+
+			size_t getShardCount() const;
+			kt::TCPServerSocket& getShard(const size_t&);
+			const kt::TCPServerSocket& getShard(const size_t&) const;
+			kt::TCPSocket accept(const size_t&, const long& = 0) const;
+
+			kt::InternetProtocolVersion getInternetProtocolVersion() const;
+			unsigned short getPort() const;
+			kt::SocketAddress getSocketAddress() const;
+			std::vector<SOCKET> getSockets() const;
+
+			void close();
+	};
+
+} // End namespace kt
@@ -198,6 +198,20 @@ namespace kt
     }
 
     kt::TCPSocket kt::TCPServerSocket::accept(const long& timeout) const
+    {
+        return this->accept(timeout, false);
+    }
+
+    /**
+     * Accepts the next incoming connection.
+     *
+     * @param timeout - The amount of microseconds to wait for a connection, 0 waits until one arrives.
+     * @param nonBlocking - When *true* the accepted socket is returned in non-blocking mode.
+     *
+     * @throw TimeoutException - If no connection arrives within the timeout.
+     * @throw SocketException - If the connection cannot be accepted.
+     */
+    kt::TCPSocket kt::TCPServerSocket::accept(const long& timeout, const bool& nonBlocking) const
     {
         if (timeout > 0)
         {
@@ -214,20 +228,97 @@ namespace kt
 
         kt::SocketAddress acceptedAddress{};
         socklen_t sockLen = sizeof(acceptedAddress);
+#ifdef __linux__
+        // accept4() creates the socket in non-blocking mode directly, saving the extra fcntl() calls
+        SOCKET temp = ::accept4(this->socketDescriptor, &acceptedAddress.address, &sockLen, nonBlocking ? SOCK_NONBLOCK : 0);
+#else
         SOCKET temp = ::accept(this->socketDescriptor, &acceptedAddress.address, &sockLen);
+#endif
         if (isInvalidSocket(temp))
         {
             throw kt::SocketException("Failed to accept connection. Socket is in an invalid state.");
         }
 
-        unsigned int portNum = this->getInternetProtocolVersion() == kt::InternetProtocolVersion::IPV6 ? htons(acceptedAddress.ipv6.sin6_port) : htons(acceptedAddress.ipv4.sin_port);
-        std::optional<std::string> hostname = kt::getAddress(acceptedAddress);
-		if (!hostname.has_value())
-		{
-            throw kt::SocketException("Unable to resolve accepted hostname from accepted socket.");
-		}
+#ifndef __linux__
+        if (nonBlocking && !Socket::setNonBlocking(temp, true))
+        {
+            Socket::close(temp);
+            throw kt::SocketException("Failed to set accepted connection to non-blocking mode: " + getErrorCode());
+        }
+#endif
+
+        // The hostname is left empty and only formatted from the address if the accepted socket is asked for it
+        const unsigned short portNum = static_cast<unsigned short>(kt::getPortNumber(acceptedAddress));
+        return kt::TCPSocket(temp, std::string(), portNum, this->getInternetProtocolVersion(), acceptedAddress);
+    }
+
+    /**
+     * Exception-free *accept()*, intended for polling loops where an idle timeout is the normal case.
+     *
+     * @param timeout - The amount of microseconds to wait for a connection, 0 waits until one arrives.
+     * @param nonBlocking - When *true* the accepted socket is returned in non-blocking mode.
+     *
+     * @return the accepted socket, or *Timeout*, *WouldBlock*, *InvalidSocket* or *System* if no connection was accepted.
+     */
+    kt::Result<kt::TCPSocket> kt::TCPServerSocket::tryAccept(const long& timeout, const bool& nonBlocking) const noexcept
+    {
+        if (isInvalidSocket(this->socketDescriptor))
+        {
+            return kt::Result<kt::TCPSocket>(kt::ResultError::InvalidSocket);
+        }
 
-        return kt::TCPSocket(temp, hostname.value(), portNum, this->getInternetProtocolVersion(), acceptedAddress);
+        if (timeout > 0)
+        {
+            int res = Socket::pollSocket(this->socketDescriptor, timeout);
+            if (res == -1)
+            {
+                return kt::Result<kt::TCPSocket>(kt::ResultError::InvalidSocket);
+            }
+            else if (res == 0)
+            {
+                return kt::Result<kt::TCPSocket>(kt::ResultError::Timeout);
+            }
+        }
+
+        kt::SocketAddress acceptedAddress{};
+        socklen_t sockLen = sizeof(acceptedAddress);
+        SOCKET temp = Socket::acceptSocket(this->socketDescriptor, &acceptedAddress.address, &sockLen, nonBlocking, false);
+        if (isInvalidSocket(temp))
+        {
+            return kt::Result<kt::TCPSocket>(kt::isWouldBlockError() ? kt::ResultError::WouldBlock : kt::ResultError::System, kt::getLastError());
+        }
+        return kt::Result<kt::TCPSocket>(kt::TCPSocket(temp, std::string(), static_cast<unsigned short>(kt::getPortNumber(acceptedAddress)), this->protocolVersion, acceptedAddress));
+    }
+
+    /**
+     * Waits once for a connection and then accepts every connection already queued, up to *max*. The listener's mode is never
+     * changed. On a non-blocking listener a burst of connections costs a single wait and one *accept4()* per connection, plus the
+     * final one that reports the queue is empty. On a blocking listener each further connection also costs a poll that does not
+     * wait, and if another thread accepts the last queued connection between that poll and the accept, this blocks until the next
+     * connection arrives, so put the descriptor from *getSocket()* in non-blocking mode before sharing it between threads.
+     *
+     * @param max - The most connections to accept.
+     * @param timeout - The amount of microseconds to wait for the first connection, 0 waits until one arrives on a blocking
+     * listener and does not wait on a non-blocking one.
+     * @param nonBlocking - When *true* the accepted sockets are returned in non-blocking mode.
+     * @param closeOnExec - When *true* the accepted sockets are not inherited by child processes started with *exec()*.
+     *
+     * @return the accepted sockets, which may be fewer than *max*. On a non-blocking listener it is empty if another thread accepted
+     * the pending connection first.
+     *
+     * @throw TimeoutException - If no connection arrives within the timeout.
+     * @throw SocketException - If no connection could be accepted.
+     */
+    std::vector<kt::TCPSocket> kt::TCPServerSocket::acceptMany(const unsigned int& max, const long& timeout, const bool& nonBlocking, const bool& closeOnExec) const
+    {
+        std::vector<kt::TCPSocket> accepted;
+        this->acceptSockets(this->socketDescriptor, max, timeout, nonBlocking, closeOnExec, [this, &accepted](const SOCKET& socket, const sockaddr_storage& address)
+        {
+            kt::SocketAddress acceptedAddress{};
+            std::memcpy(&acceptedAddress, &address, sizeof(acceptedAddress));
+            accepted.emplace_back(socket, std::string(), static_cast<unsigned short>(kt::getPortNumber(acceptedAddress)), this->protocolVersion, acceptedAddress);
+        });
+        return accepted;
     }
 
     /**
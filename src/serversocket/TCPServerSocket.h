@@ -2,10 +2,12 @@
 
 #include <optional>
 #include <functional>
+#include <vector>
 
 #include "../address/SocketAddress.h"
 #include "../socket/TCPSocket.h"
 #include "../enums/InternetProtocolVersion.h"
+#include "../socketexceptions/Result.h"
 #include "ServerSocket.h"
 
 #ifdef _WIN32
@@ -53,10 +55,13 @@ namespace kt
 			kt::TCPServerSocket& operator=(const kt::TCPServerSocket&);
 
 			kt::TCPSocket accept(const long& = 0) const override;
+			kt::TCPSocket accept(const long&, const bool&) const;
+			kt::Result<kt::TCPSocket> tryAccept(const long& = 0, const bool& = false) const noexcept;
+			std::vector<kt::TCPSocket> acceptMany(const unsigned int&, const long& = 0, const bool& = false, const bool& = false) const;
 
 			kt::InternetProtocolVersion getInternetProtocolVersion() const;
 			unsigned short getPort() const;
-			SOCKET getSocket() const;
+			SOCKET getSocket() const override;
 			kt::SocketAddress getSocketAddress() const;
 
 			void close() override;
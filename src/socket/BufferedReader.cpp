@@ -0,0 +1,234 @@
+#include "BufferedReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+
+#include <WinSock2.h>
+
+#else
+
+#include <sys/socket.h>
+
+#endif
+
+namespace kt
+{
+    /**
+     * BufferedReader constructor.
+     *
+     * @param socket - The connected socket to read from.
+     * @param capacity - The initial size of the internal buffer and the largest amount requested from the socket per read. The buffer
+     * only grows beyond this if a single delimited or exact read does not fit.
+     */
+    BufferedReader::BufferedReader(kt::ConnectionOrientedSocket& socket, const size_t& capacity) : socket(socket)
+    {
+        this->buffer.resize(capacity == 0 ? 1 : capacity);
+    }
+
+    /**
+     * Performs a single read from the socket into the free space at the end of the buffer, making space first if required.
+     *
+     * @return the amount of bytes read, 0 if the socket was not ready within the timeout or has reached EOF, or -1 on a receive error.
+     */
+    int BufferedReader::fill(const unsigned long& timeout, const int& flags)
+    {
+        if (this->hitEOF)
+        {
+            return 0;
+        }
+
+        if (this->writeIndex == this->buffer.size())
+        {
+            if (this->readIndex > 0)
+            {
+                // Move the unread bytes to the front so the existing buffer is reused rather than grown
+                std::memmove(this->buffer.data(), this->buffer.data() + this->readIndex, this->writeIndex - this->readIndex);
+                this->writeIndex -= this->readIndex;
+                this->scannedIndex -= this->readIndex;
+                this->readIndex = 0;
+            }
+            else
+            {
+                this->buffer.resize(this->buffer.size() * 2);
+            }
+        }
+
+        if (!this->socket.ready(timeout))
+        {
+            return 0;
+        }
+
+        int received = ::recv(this->socket.getSocket(), this->buffer.data() + this->writeIndex, static_cast<int>(this->buffer.size() - this->writeIndex), flags);
+        if (received == 0)
+        {
+            this->hitEOF = true;
+            return 0;
+        }
+        else if (received < 0)
+        {
+            return -1;
+        }
+
+        this->writeIndex += received;
+        return received;
+    }
+
+    /**
+     * Reads until the provided delimiter is found. The delimiter is discarded and the characters preceeding it are returned.
+     *
+     * @param delimiter - The character marking the end of the read.
+     * @param timeout - The amount of microseconds to wait for more data each time the buffer runs out.
+     *
+     * @return the characters preceeding the delimiter, or *std::nullopt* if the delimiter was not received before the timeout or EOF.
+     * In that case the received characters are kept and will be included in the next read.
+     */
+    std::optional<std::string> BufferedReader::readUntil(const char& delimiter, const unsigned long& timeout, const int& flags)
+    {
+        while (true)
+        {
+            const void* found = std::memchr(this->buffer.data() + this->scannedIndex, delimiter, this->writeIndex - this->scannedIndex);
+            if (found != nullptr)
+            {
+                const size_t delimiterIndex = static_cast<const char*>(found) - this->buffer.data();
+                std::string result(this->buffer.data() + this->readIndex, delimiterIndex - this->readIndex);
+
+                this->readIndex = delimiterIndex + 1;
+                this->scannedIndex = this->readIndex;
+                if (this->readIndex == this->writeIndex)
+                {
+                    this->clear();
+                }
+                return result;
+            }
+
+            // Anything already scanned does not need to be searched again after the next fill
+            this->scannedIndex = this->writeIndex;
+            if (this->fill(timeout, flags) <= 0)
+            {
+                return std::nullopt;
+            }
+        }
+    }
+
+    /**
+     * Reads until the next '\n', removing it and any preceeding '\r' from the returned line.
+     *
+     * @return the line, or *std::nullopt* if a full line was not received before the timeout or EOF.
+     */
+    std::optional<std::string> BufferedReader::readLine(const unsigned long& timeout, const int& flags)
+    {
+        std::optional<std::string> line = this->readUntil('\n', timeout, flags);
+        if (line.has_value() && !line->empty() && line->back() == '\r')
+        {
+            line->pop_back();
+        }
+        return line;
+    }
+
+    /**
+     * Reads exactly the requested amount of characters.
+     *
+     * @return the characters, or *std::nullopt* if they were not all received before the timeout or EOF. The characters that were
+     * received are kept and will be included in the next read.
+     */
+    std::optional<std::string> BufferedReader::readExact(const size_t& amountToReceive, const unsigned long& timeout, const int& flags)
+    {
+        std::string data;
+        data.resize(amountToReceive);
+        if (!this->readExact(&data[0], amountToReceive, timeout, flags))
+        {
+            return std::nullopt;
+        }
+        return data;
+    }
+
+    /**
+     * Reads exactly the requested amount of characters into the provided buffer.
+     *
+     * @return *true* if the buffer was filled, otherwise *false* and the buffer is left untouched.
+     */
+    bool BufferedReader::readExact(char* destination, const size_t& amountToReceive, const unsigned long& timeout, const int& flags)
+    {
+        while (this->available() < amountToReceive)
+        {
+            if (this->fill(timeout, flags) <= 0)
+            {
+                return false;
+            }
+        }
+
+        std::memcpy(destination, this->buffer.data() + this->readIndex, amountToReceive);
+        this->readIndex += amountToReceive;
+        this->scannedIndex = this->readIndex;
+        if (this->readIndex == this->writeIndex)
+        {
+            this->clear();
+        }
+        return true;
+    }
+
+    /**
+     * Reads up to the requested amount of characters. Buffered characters are returned without touching the socket, otherwise a
+     * single read from the socket is performed.
+     *
+     * @return the amount of characters copied into the destination buffer.
+     */
+    size_t BufferedReader::read(char* destination, const size_t& maximumAmount, const unsigned long& timeout, const int& flags)
+    {
+        if (maximumAmount == 0)
+        {
+            return 0;
+        }
+
+        if (this->available() == 0 && this->fill(timeout, flags) <= 0)
+        {
+            return 0;
+        }
+
+        const size_t amount = std::min(maximumAmount, this->available());
+        std::memcpy(destination, this->buffer.data() + this->readIndex, amount);
+        this->readIndex += amount;
+        this->scannedIndex = std::max(this->scannedIndex, this->readIndex);
+        if (this->readIndex == this->writeIndex)
+        {
+            this->clear();
+        }
+        return amount;
+    }
+
+    /**
+     * @return *true* if there are buffered characters or the underlying socket has data ready to be read.
+     */
+    bool BufferedReader::ready(const unsigned long& timeout) const
+    {
+        return this->available() > 0 || this->socket.ready(timeout);
+    }
+
+    /**
+     * @return the amount of characters that have been received but not yet returned.
+     */
+    size_t BufferedReader::available() const
+    {
+        return this->writeIndex - this->readIndex;
+    }
+
+    /**
+     * @return *true* once the remote has closed the connection and every buffered character has been returned.
+     */
+    bool BufferedReader::isEOF() const
+    {
+        return this->hitEOF && this->available() == 0;
+    }
+
+    /**
+     * Discards any buffered characters.
+     */
+    void BufferedReader::clear()
+    {
+        this->readIndex = 0;
+        this->writeIndex = 0;
+        this->scannedIndex = 0;
+    }
+}
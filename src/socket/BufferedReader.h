@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ConnectionOrientedSocket.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace kt
+{
+    /**
+     * Reads from a *kt::ConnectionOrientedSocket* in large chunks and serves delimited or fixed size reads from its own buffer.
+     * Any bytes read past the end of a request are kept and returned by the next call, so a BufferedReader should be the only
+     * thing reading from its socket once it is attached.
+     *
+     * The socket is held by reference and must outlive the reader.
+     */
+    class BufferedReader
+    {
+        private:
+            kt::ConnectionOrientedSocket& socket;
+            std::vector<char> buffer;
+            size_t readIndex = 0;
+            size_t writeIndex = 0;
+            size_t scannedIndex = 0;
+            bool hitEOF = false;
+
+            int fill(const unsigned long&, const int&);
+
+        public:
+            BufferedReader(kt::ConnectionOrientedSocket&, const size_t& = 8192);
+
+            std::optional<std::string> readUntil(const char&, const unsigned long& = 100, const int& = 0);
+            std::optional<std::string> readLine(const unsigned long& = 100, const int& = 0);
+            std::optional<std::string> readExact(const size_t&, const unsigned long& = 100, const int& = 0);
+            bool readExact(char*, const size_t&, const unsigned long& = 100, const int& = 0);
+            size_t read(char*, const size_t&, const unsigned long& = 100, const int& = 0);
+
+            bool ready(const unsigned long& = 100) const;
+            size_t available() const;
+            bool isEOF() const;
+            void clear();
+    };
+}
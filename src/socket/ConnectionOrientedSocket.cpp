@@ -1,9 +1,111 @@
 #include "ConnectionOrientedSocket.h"
 
 #include "../socketexceptions/SocketException.hpp"
+#include "../socketexceptions/SocketError.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+
+#include <io.h>
+
+#else
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#endif
+
+#ifdef __linux__
+
+#include <sys/sendfile.h>
+
+#endif
 
 namespace kt
 {
+	namespace
+	{
+		// The most buffers a single scatter-gather send accepts, larger buffer lists are sent over several calls.
+		// Where the platform does not define IOV_MAX, 1024 matches the Linux limit.
+#ifdef IOV_MAX
+		const size_t MAX_SEND_VECTORS = IOV_MAX;
+#else
+		const size_t MAX_SEND_VECTORS = 1024;
+#endif
+	}
+
+#ifdef __linux__
+	namespace
+	{
+		// The default pipe capacity, so each splice into the pipe can always be drained completely
+		const size_t SPLICE_CHUNK_SIZE = 64 * 1024;
+
+		/**
+		 * Moves file data to the socket through a pipe with *splice()*, for files that *sendfile()* refuses. Data left in the pipe
+		 * when the socket would block is discarded, since it is read again from the file at the returned offset on resume.
+		 */
+		std::pair<size_t, kt::IOStatus> spliceFile(const SOCKET& socket, const int& fileDescriptor, const int64_t& offset, const size_t& length)
+		{
+			int pipes[2];
+			if (::pipe2(pipes, O_CLOEXEC) == -1)
+			{
+				return std::make_pair(static_cast<size_t>(0), kt::IOStatus::Error);
+			}
+
+			size_t sent = 0;
+			kt::IOStatus status = kt::IOStatus::Complete;
+			while (sent < length && status == kt::IOStatus::Complete)
+			{
+				loff_t position = static_cast<loff_t>(offset + sent);
+				const ssize_t moved = ::splice(fileDescriptor, &position, pipes[1], nullptr, std::min(length - sent, SPLICE_CHUNK_SIZE), SPLICE_F_MOVE);
+				if (moved == 0)
+				{
+					break;
+				}
+				else if (moved < 0)
+				{
+					if (errno != EINTR)
+					{
+						status = kt::IOStatus::Error;
+					}
+					continue;
+				}
+
+				ssize_t drained = 0;
+				while (drained < moved)
+				{
+					const ssize_t written = ::splice(pipes[0], nullptr, socket, nullptr, moved - drained, SPLICE_F_MOVE);
+					if (written < 0)
+					{
+						if (errno == EINTR)
+						{
+							continue;
+						}
+						status = kt::isWouldBlockError() ? kt::IOStatus::WouldBlock : kt::isConnectionClosedError() ? kt::IOStatus::Closed : kt::IOStatus::Error;
+						break;
+					}
+					drained += written;
+				}
+				sent += static_cast<size_t>(drained);
+			}
+
+			::close(pipes[0]);
+			::close(pipes[1]);
+			return std::make_pair(sent, status);
+		}
+	}
+
+#endif
+
     bool ConnectionOrientedSocket::ready(const unsigned long timeout) const
 	{
 		int result = this->pollSocket(getSocket(), timeout);
@@ -18,6 +120,22 @@ namespace kt
 		return result != -1;
 	}
 
+	/**
+	 * Switches this socket between blocking and non-blocking mode. In non-blocking mode *sendPartial()* and *receivePartial()*
+	 * return as soon as the socket can make no further progress, rather than waiting.
+	 *
+	 * @return *true* if the mode was changed successfully.
+	 */
+	bool ConnectionOrientedSocket::setNonBlocking(const bool& nonBlocking)
+	{
+		return Socket::setNonBlocking(getSocket(), nonBlocking);
+	}
+
+	bool ConnectionOrientedSocket::isNonBlocking() const
+	{
+		return Socket::isNonBlocking(getSocket());
+	}
+
     int ConnectionOrientedSocket::send(const char* message, const int& messageLength, const int& flags) const
 	{
 		return ::send(getSocket(), message, messageLength, flags);
@@ -71,21 +189,39 @@ namespace kt
 			throw kt::SocketException("The null terminator '\\0' is an invalid delimiter.");
 		}
 
+		// Peek at whatever is available and only consume up to and including the delimiter, so that a whole chunk is handled
+		// per receive while any data following the delimiter is left for the next read.
+		const int chunkSize = 4096;
 		std::string data;
-		if (!this->ready())
+		while (this->ready())
 		{
-			return data;
-		}
+			const size_t offset = data.size();
+			data.resize(offset + chunkSize);
 
-		std::optional<char> character;
-		do
-		{
-			character = this->get(flags);
-			if (character.has_value() && *character != delimiter)
+			int peeked = ::recv(getSocket(), &data[offset], chunkSize, flags | MSG_PEEK);
+			if (peeked < 1)
 			{
-				data += *character;
+				data.resize(offset);
+				break;
 			}
-		} while (character.has_value() && *character != delimiter && this->ready());
+
+			const void* found = std::memchr(&data[offset], delimiter, peeked);
+			const int amountToConsume = found == nullptr ? peeked : static_cast<int>(static_cast<const char*>(found) - &data[offset]) + 1;
+			int consumed = ::recv(getSocket(), &data[offset], amountToConsume, flags);
+			if (consumed < 1)
+			{
+				data.resize(offset);
+				break;
+			}
+
+			if (found != nullptr && consumed == amountToConsume)
+			{
+				// Drop the delimiter
+				data.resize(offset + consumed - 1);
+				break;
+			}
+			data.resize(offset + consumed);
+		}
 
 		return data;
 	}
@@ -111,6 +247,401 @@ namespace kt
 		return counter;
 	}
 
+	/**
+	 * Sends as much of the provided buffer as the socket will accept without polling between calls.
+	 * On a blocking socket this behaves like a send that loops until everything is sent.
+	 *
+	 * @return the amount of characters sent along with the reason the call returned. When the status is *kt::IOStatus::WouldBlock*
+	 * the remainder should be sent once the socket is writable again.
+	 */
+	std::pair<int, kt::IOStatus> ConnectionOrientedSocket::sendPartial(const char* message, const int& messageLength, const int& flags) const
+	{
+		int sent = 0;
+		while (sent < messageLength)
+		{
+			int result = ::send(getSocket(), message + sent, messageLength - sent, flags);
+			if (result < 0)
+			{
+				if (kt::isWouldBlockError())
+				{
+					return std::make_pair(sent, kt::IOStatus::WouldBlock);
+				}
+				return std::make_pair(sent, kt::isConnectionClosedError() ? kt::IOStatus::Closed : kt::IOStatus::Error);
+			}
+			sent += result;
+		}
+		return std::make_pair(sent, kt::IOStatus::Complete);
+	}
+
+	/**
+	 * Receives up to the requested amount of characters without polling between calls.
+	 * On a blocking socket this waits until the full amount has been received or the connection is closed.
+	 *
+	 * @return the amount of characters received along with the reason the call returned.
+	 */
+	std::pair<int, kt::IOStatus> ConnectionOrientedSocket::receivePartial(char* buffer, const int& amountToReceive, const int& flags) const
+	{
+		int received = 0;
+		while (received < amountToReceive)
+		{
+			int result = ::recv(getSocket(), buffer + received, amountToReceive - received, flags);
+			if (result == 0)
+			{
+				return std::make_pair(received, kt::IOStatus::Closed);
+			}
+			else if (result < 0)
+			{
+				if (kt::isWouldBlockError())
+				{
+					return std::make_pair(received, kt::IOStatus::WouldBlock);
+				}
+				return std::make_pair(received, kt::isConnectionClosedError() ? kt::IOStatus::Closed : kt::IOStatus::Error);
+			}
+			received += result;
+		}
+		return std::make_pair(received, kt::IOStatus::Complete);
+	}
+
+	/**
+	 * Sends the whole buffer, waiting for the socket to become writable whenever it is full, until everything is sent, the
+	 * connection fails or the timeout passes. Works the same for blocking and non-blocking sockets.
+	 *
+	 * @param message - The data to send.
+	 * @param messageLength - The amount of bytes to send.
+	 * @param timeout - The amount of microseconds the whole send may take, 0 waits for as long as it takes.
+	 * @param flags - Additional flags passed to each underlying send call.
+	 *
+	 * @return the amount of bytes sent along with the reason the call returned, *kt::IOStatus::Timeout* if the timeout passed first.
+	 */
+	std::pair<size_t, kt::IOStatus> ConnectionOrientedSocket::sendAll(const char* message, const size_t& messageLength, const long& timeout, const int& flags) const
+	{
+		const std::string_view buffer(message, messageLength);
+		return this->sendv(&buffer, 1, timeout, flags);
+	}
+
+	std::pair<size_t, kt::IOStatus> ConnectionOrientedSocket::sendAll(const std::string& message, const long& timeout, const int& flags) const
+	{
+		return this->sendAll(message.c_str(), message.size(), timeout, flags);
+	}
+
+	/**
+	 * Sends several buffers in order as one stream of bytes using *sendmsg()* (*WSASend()* on Windows), so for example a header and
+	 * body are sent in one call without first being joined together. Like *sendAll()* this continues until every buffer is sent.
+	 *
+	 * @param buffers - The buffers to send, which may include empty buffers.
+	 * @param count - The amount of buffers.
+	 * @param timeout - The amount of microseconds the whole send may take, 0 waits for as long as it takes.
+	 * @param flags - Additional flags passed to each underlying send call.
+	 *
+	 * @return the total amount of bytes sent along with the reason the call returned, *kt::IOStatus::Timeout* if the timeout passed
+	 * first.
+	 */
+	std::pair<size_t, kt::IOStatus> ConnectionOrientedSocket::sendv(const std::string_view* buffers, const size_t& count, const long& timeout, const int& flags) const
+	{
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+		int sendFlags = flags;
+#ifdef MSG_DONTWAIT
+		// A blocking send could otherwise wait past the deadline
+		if (timeout > 0)
+		{
+			sendFlags |= MSG_DONTWAIT;
+		}
+#endif
+
+#ifdef _WIN32
+		std::vector<WSABUF> vectors;
+#else
+		std::vector<iovec> vectors;
+#endif
+		size_t total = 0;
+		size_t index = 0;
+		size_t offset = 0;
+		while (true)
+		{
+			while (index < count && offset == buffers[index].size())
+			{
+				index++;
+				offset = 0;
+			}
+			if (index == count)
+			{
+				return std::make_pair(total, kt::IOStatus::Complete);
+			}
+
+			vectors.clear();
+			for (size_t i = index; i < count && vectors.size() < MAX_SEND_VECTORS; i++)
+			{
+				const size_t start = i == index ? offset : 0;
+				if (buffers[i].size() > start)
+				{
+#ifdef _WIN32
+					vectors.push_back(WSABUF{ static_cast<ULONG>(buffers[i].size() - start), const_cast<char*>(buffers[i].data() + start) });
+#else
+					vectors.push_back(iovec{ const_cast<char*>(buffers[i].data() + start), buffers[i].size() - start });
+#endif
+				}
+			}
+
+#ifdef _WIN32
+			DWORD sentBytes = 0;
+			const long long sent = WSASend(getSocket(), vectors.data(), static_cast<DWORD>(vectors.size()), &sentBytes, static_cast<DWORD>(sendFlags), nullptr, nullptr) == 0 ? static_cast<long long>(sentBytes) : -1;
+#else
+			msghdr message{};
+			message.msg_iov = vectors.data();
+			message.msg_iovlen = vectors.size();
+			const ssize_t sent = ::sendmsg(getSocket(), &message, sendFlags);
+			if (sent < 0 && errno == EINTR)
+			{
+				continue;
+			}
+#endif
+			if (sent > 0)
+			{
+				total += static_cast<size_t>(sent);
+				size_t remaining = static_cast<size_t>(sent);
+				while (remaining > 0)
+				{
+					const size_t available = buffers[index].size() - offset;
+					if (remaining < available)
+					{
+						offset += remaining;
+						break;
+					}
+					remaining -= available;
+					index++;
+					offset = 0;
+				}
+				continue;
+			}
+			else if (sent < 0 && !kt::isWouldBlockError())
+			{
+				return std::make_pair(total, kt::isConnectionClosedError() ? kt::IOStatus::Closed : kt::IOStatus::Error);
+			}
+
+			long wait = -1;
+			if (timeout > 0)
+			{
+				wait = static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count());
+				if (wait <= 0)
+				{
+					return std::make_pair(total, kt::IOStatus::Timeout);
+				}
+			}
+
+			const int ready = this->pollSocketWritable(getSocket(), wait);
+			if (ready == 0)
+			{
+				return std::make_pair(total, kt::IOStatus::Timeout);
+			}
+			else if (ready < 0)
+			{
+				return std::make_pair(total, kt::IOStatus::Error);
+			}
+		}
+	}
+
+	std::pair<size_t, kt::IOStatus> ConnectionOrientedSocket::sendv(const std::vector<std::string_view>& buffers, const long& timeout, const int& flags) const
+	{
+		return this->sendv(buffers.data(), buffers.size(), timeout, flags);
+	}
+
+	/**
+	 * Sends part of a file without copying it through user space, using *sendfile()* on Linux and *splice()* through a pipe for
+	 * files that *sendfile()* does not support. Other platforms read the file into a buffer and send it.
+	 * The file's own offset is not used or changed.
+	 *
+	 * @param fileDescriptor - The file to read from, opened for reading.
+	 * @param offset - The position in the file to start sending from.
+	 * @param length - The amount of bytes to send.
+	 *
+	 * @return the amount of bytes sent along with the reason the call returned. When the status is *kt::IOStatus::WouldBlock* the
+	 * remainder should be sent from *offset* plus the amount sent once the socket is writable again. If the file ends first, fewer
+	 * than *length* bytes are sent and the status is *kt::IOStatus::Complete*.
+	 */
+	std::pair<size_t, kt::IOStatus> ConnectionOrientedSocket::sendFile(const int& fileDescriptor, const int64_t& offset, const size_t& length) const
+	{
+		size_t sent = 0;
+#ifdef __linux__
+		while (sent < length)
+		{
+			off_t position = static_cast<off_t>(offset + sent);
+			const ssize_t result = ::sendfile(getSocket(), fileDescriptor, &position, length - sent);
+			if (result == 0)
+			{
+				break;
+			}
+			else if (result < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				if (errno == EINVAL || errno == ENOSYS)
+				{
+					std::pair<size_t, kt::IOStatus> spliced = kt::spliceFile(getSocket(), fileDescriptor, offset + sent, length - sent);
+					return std::make_pair(sent + spliced.first, spliced.second);
+				}
+				if (kt::isWouldBlockError())
+				{
+					return std::make_pair(sent, kt::IOStatus::WouldBlock);
+				}
+				return std::make_pair(sent, kt::isConnectionClosedError() ? kt::IOStatus::Closed : kt::IOStatus::Error);
+			}
+			sent += static_cast<size_t>(result);
+		}
+
+#else
+		std::vector<char> buffer(std::min(length, static_cast<size_t>(64 * 1024)));
+		while (sent < length)
+		{
+#ifdef _WIN32
+			int amountRead = -1;
+			if (_lseeki64(fileDescriptor, offset + sent, SEEK_SET) != -1)
+			{
+				amountRead = _read(fileDescriptor, buffer.data(), static_cast<unsigned int>(std::min(length - sent, buffer.size())));
+			}
+#else
+			const ssize_t amountRead = ::pread(fileDescriptor, buffer.data(), std::min(length - sent, buffer.size()), static_cast<off_t>(offset + sent));
+#endif
+			if (amountRead == 0)
+			{
+				break;
+			}
+			else if (amountRead < 0)
+			{
+				return std::make_pair(sent, kt::IOStatus::Error);
+			}
+
+			std::pair<int, kt::IOStatus> result = this->sendPartial(buffer.data(), static_cast<int>(amountRead));
+			sent += static_cast<size_t>(result.first);
+			if (result.second != kt::IOStatus::Complete)
+			{
+				return std::make_pair(sent, result.second);
+			}
+		}
+
+#endif
+		return std::make_pair(sent, kt::IOStatus::Complete);
+	}
+
+	/**
+	 * Opens the file at the provided path and sends it with *sendFile(const int&, const int64_t&, const size_t&)*.
+	 *
+	 * @param path - The file to send.
+	 * @param offset - The position in the file to start sending from.
+	 * @param length - The amount of bytes to send, by default everything from *offset* to the end of the file.
+	 *
+	 * @return the amount of bytes sent along with the reason the call returned, *kt::IOStatus::Error* if the file could not be opened.
+	 */
+	std::pair<size_t, kt::IOStatus> ConnectionOrientedSocket::sendFile(const std::string& path, const int64_t& offset, const std::optional<size_t>& length) const
+	{
+#ifdef _WIN32
+		const int fileDescriptor = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+		const int fileDescriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+		if (fileDescriptor == -1)
+		{
+			return std::make_pair(static_cast<size_t>(0), kt::IOStatus::Error);
+		}
+
+		size_t amount = length.value_or(0);
+		if (!length.has_value())
+		{
+#ifdef _WIN32
+			struct _stat64 status{};
+			const bool found = _fstat64(fileDescriptor, &status) == 0;
+#else
+			struct stat status{};
+			const bool found = ::fstat(fileDescriptor, &status) == 0;
+#endif
+			if (!found)
+			{
+#ifdef _WIN32
+				_close(fileDescriptor);
+#else
+				::close(fileDescriptor);
+#endif
+				return std::make_pair(static_cast<size_t>(0), kt::IOStatus::Error);
+			}
+			amount = status.st_size > offset ? static_cast<size_t>(status.st_size - offset) : 0;
+		}
+
+		std::pair<size_t, kt::IOStatus> result = this->sendFile(fileDescriptor, offset, amount);
+#ifdef _WIN32
+		_close(fileDescriptor);
+#else
+		::close(fileDescriptor);
+#endif
+		return result;
+	}
+
+	/**
+	 * Exception-free *send()*, reporting why nothing could be sent instead of returning -1.
+	 *
+	 * @return the amount of characters sent, or *WouldBlock*, *Closed* or *System* if the send failed.
+	 */
+	kt::Result<int> ConnectionOrientedSocket::trySend(const char* message, const int& messageLength, const int& flags) const noexcept
+	{
+		if (kt::isInvalidSocket(getSocket()))
+		{
+			return kt::Result<int>(kt::ResultError::InvalidSocket);
+		}
+
+		const int sent = ::send(getSocket(), message, messageLength, flags);
+		if (sent >= 0)
+		{
+			return kt::Result<int>(sent);
+		}
+		if (kt::isWouldBlockError())
+		{
+			return kt::Result<int>(kt::ResultError::WouldBlock);
+		}
+		return kt::Result<int>(kt::isConnectionClosedError() ? kt::ResultError::Closed : kt::ResultError::System, kt::getLastError());
+	}
+
+	/**
+	 * Exception-free *receiveAmount()* into the provided buffer. Returns early once the connection is closed or no more data arrives.
+	 *
+	 * @return the amount of characters received, or *Closed*, *WouldBlock* or *System* if nothing could be received.
+	 */
+	kt::Result<int> ConnectionOrientedSocket::tryReceiveAmount(char* buffer, const unsigned int amountToReceive, const int& flags) const noexcept
+	{
+		if (kt::isInvalidSocket(getSocket()))
+		{
+			return kt::Result<int>(kt::ResultError::InvalidSocket);
+		}
+
+		int counter = 0;
+		while (counter < static_cast<int>(amountToReceive))
+		{
+			const int received = ::recv(getSocket(), &buffer[counter], static_cast<int>(amountToReceive - counter), flags);
+			if (received == 0)
+			{
+				return counter > 0 ? kt::Result<int>(counter) : kt::Result<int>(kt::ResultError::Closed);
+			}
+			else if (received < 0)
+			{
+				if (counter > 0)
+				{
+					break;
+				}
+				if (kt::isWouldBlockError())
+				{
+					return kt::Result<int>(kt::ResultError::WouldBlock);
+				}
+				return kt::Result<int>(kt::isConnectionClosedError() ? kt::ResultError::Closed : kt::ResultError::System, kt::getLastError());
+			}
+
+			counter += received;
+			if (counter < static_cast<int>(amountToReceive) && !this->ready())
+			{
+				break;
+			}
+		}
+		return kt::Result<int>(counter);
+	}
+
     /**
 	 * Reads data while the stream is *ready()*.
 	 *
@@ -122,22 +653,70 @@ namespace kt
 	std::string kt::ConnectionOrientedSocket::receiveAll(const unsigned long timeout, const int& flags)
 	{
 		std::string result;
-		result.reserve(1024);
-		bool hitEOF = false;
+		this->receiveAll(result, timeout, flags);
+		return result;
+	}
+
+	/**
+	 * Reads data while the stream is *ready()*, appending it to the provided buffer. Each read requests everything the socket
+	 * reports as available, or a chunk size that doubles each time a read fills it, whichever is larger.
+	 *
+	 * @param buffer - The buffer that received data is appended to.
+	 * @param timeout - The amount of microseconds to wait for more data before returning.
+	 *
+	 * @return the amount of characters appended along with why the call returned: *kt::IOStatus::Complete* if no more data arrived
+	 * within the timeout and the connection is still open, *kt::IOStatus::Closed* if the remote closed or reset the connection, or
+	 * *kt::IOStatus::Error* if waiting or receiving failed for any other reason.
+	 */
+	std::pair<int, kt::IOStatus> ConnectionOrientedSocket::receiveAll(std::string& buffer, const unsigned long timeout, const int& flags)
+	{
+		const size_t initialSize = buffer.size();
+		const int maximumChunkSize = 1024 * 1024;
+		int chunkSize = 4096;
 
-		while (this->ready(timeout) && !hitEOF)
+		while (true)
 		{
-			std::string res = receiveAmount(this->pollSocket(getSocket(), timeout), flags);
-			if (!res.empty() && res[0] == '\0')
+			const int ready = this->pollSocket(getSocket(), timeout);
+			if (ready == 0)
+			{
+				return std::make_pair(static_cast<int>(buffer.size() - initialSize), kt::IOStatus::Complete);
+			}
+			else if (ready < 0)
+			{
+				return std::make_pair(static_cast<int>(buffer.size() - initialSize), kt::IOStatus::Error);
+			}
+
+			int readSize = chunkSize;
+#ifdef _WIN32
+			u_long available = 0;
+			if (ioctlsocket(getSocket(), FIONREAD, &available) == 0 && available > static_cast<u_long>(readSize))
+#else
+			int available = 0;
+			if (ioctl(getSocket(), FIONREAD, &available) == 0 && available > readSize)
+#endif
+			{
+				readSize = static_cast<int>(available);
+			}
+
+			const size_t offset = buffer.size();
+			buffer.resize(offset + readSize);
+			int received = ::recv(getSocket(), &buffer[offset], readSize, flags);
+			if (received < 1)
 			{
-				hitEOF = true;
+				buffer.resize(offset);
+				kt::IOStatus status = kt::IOStatus::Closed;
+				if (received < 0)
+				{
+					status = kt::isWouldBlockError() ? kt::IOStatus::Complete : kt::isConnectionClosedError() ? kt::IOStatus::Closed : kt::IOStatus::Error;
+				}
+				return std::make_pair(static_cast<int>(buffer.size() - initialSize), status);
 			}
-			else
+			buffer.resize(offset + received);
+
+			if (received == readSize && chunkSize < maximumChunkSize)
 			{
-				result += res;
+				chunkSize *= 2;
 			}
 		}
-		result.shrink_to_fit();
-		return result;
 	}
 }
@@ -1,9 +1,15 @@
 #pragma once
 
 #include "Socket.h"
+#include "../enums/IOStatus.h"
+#include "../socketexceptions/Result.h"
 
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace kt
 {
@@ -15,6 +21,9 @@ namespace kt
             virtual bool ready(const unsigned long = 100) const;
 			virtual bool connected(const unsigned long = 100) const;
 
+			virtual bool setNonBlocking(const bool&);
+			virtual bool isNonBlocking() const;
+
             virtual int send(const char*, const int&, const int& = 0) const;
 			virtual int send(const std::string&, const int& = 0) const;
 
@@ -24,5 +33,20 @@ namespace kt
 
             virtual int receiveAmount(char*, const unsigned int, const int& = 0) const;
 			virtual std::string receiveAll(const unsigned long = 100, const int& = 0);
+			virtual std::pair<int, kt::IOStatus> receiveAll(std::string&, const unsigned long = 100, const int& = 0);
+
+			virtual std::pair<int, kt::IOStatus> sendPartial(const char*, const int&, const int& = 0) const;
+			virtual std::pair<int, kt::IOStatus> receivePartial(char*, const int&, const int& = 0) const;
+
+			std::pair<size_t, kt::IOStatus> sendAll(const char*, const size_t&, const long& = 0, const int& = 0) const;
+			std::pair<size_t, kt::IOStatus> sendAll(const std::string&, const long& = 0, const int& = 0) const;
+			std::pair<size_t, kt::IOStatus> sendv(const std::string_view*, const size_t&, const long& = 0, const int& = 0) const;
+			std::pair<size_t, kt::IOStatus> sendv(const std::vector<std::string_view>&, const long& = 0, const int& = 0) const;
+
+			std::pair<size_t, kt::IOStatus> sendFile(const int&, const int64_t&, const size_t&) const;
+			std::pair<size_t, kt::IOStatus> sendFile(const std::string&, const int64_t& = 0, const std::optional<size_t>& = std::nullopt) const;
+
+			kt::Result<int> trySend(const char*, const int&, const int& = 0) const noexcept;
+			kt::Result<int> tryReceiveAmount(char*, const unsigned int, const int& = 0) const noexcept;
     };
 }
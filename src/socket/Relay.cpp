@@ -0,0 +1,347 @@
+#include "Relay.h"
+#include "../socketexceptions/SocketError.h"
+
+#include <cerrno>
+#include <vector>
+
+#ifdef _WIN32
+
+#include <WinSock2.h>
+
+#else
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#endif
+
+#ifdef __linux__
+
+#include <fcntl.h>
+
+#endif
+
+namespace kt
+{
+    namespace
+    {
+        const size_t RELAY_BUFFER_SIZE = 64 * 1024;
+
+        /**
+         * One direction of a relay. On Linux the data waits in a pipe between being spliced out of the source and into the
+         * destination, on other platforms it waits in a user space buffer.
+         */
+        struct RelayDirection
+        {
+            SOCKET source;
+            SOCKET destination;
+            std::atomic<uint64_t>& counter;
+            size_t buffered = 0;
+            size_t capacity = RELAY_BUFFER_SIZE;
+            bool sourceOpen = true;
+            bool shutDown = false;
+
+#ifdef __linux__
+            int pipes[2] = { -1, -1 };
+            // Set when the pipe refused more data before reaching its byte capacity, which happens when it is made up of small
+            // segments. Reading stops until some of the pipe is drained so a readable source does not spin the loop.
+            bool stalled = false;
+#else
+            std::vector<char> buffer;
+            size_t start = 0;
+#endif
+
+            RelayDirection(const SOCKET& source, const SOCKET& destination, std::atomic<uint64_t>& counter) : source(source), destination(destination), counter(counter) {}
+
+            bool open()
+            {
+#ifdef __linux__
+                if (::pipe2(this->pipes, O_NONBLOCK | O_CLOEXEC) == -1)
+                {
+                    return false;
+                }
+                const int size = ::fcntl(this->pipes[0], F_GETPIPE_SZ);
+                if (size > 0)
+                {
+                    this->capacity = static_cast<size_t>(size);
+                }
+#else
+                this->buffer.resize(this->capacity);
+#endif
+                return true;
+            }
+
+            void release()
+            {
+#ifdef __linux__
+                for (int& pipe : this->pipes)
+                {
+                    if (pipe != -1)
+                    {
+                        ::close(pipe);
+                        pipe = -1;
+                    }
+                }
+#endif
+            }
+
+            bool canFill() const
+            {
+#ifdef __linux__
+                return this->sourceOpen && !this->stalled && this->buffered < this->capacity;
+#else
+                return this->sourceOpen && this->start + this->buffered < this->capacity;
+#endif
+            }
+
+            kt::IOStatus failure() const
+            {
+                return kt::isConnectionClosedError() ? kt::IOStatus::Closed : kt::IOStatus::Error;
+            }
+
+            /**
+             * Reads from the source until it has nothing more, reaches EOF or there is no more space to hold the data.
+             */
+            kt::IOStatus fill()
+            {
+                while (this->canFill())
+                {
+#ifdef __linux__
+                    const ssize_t moved = ::splice(this->source, nullptr, this->pipes[1], nullptr, this->capacity - this->buffered, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+#elif defined(_WIN32)
+                    const int moved = ::recv(this->source, &this->buffer[this->start + this->buffered], static_cast<int>(this->capacity - this->start - this->buffered), 0);
+#else
+                    const ssize_t moved = ::recv(this->source, &this->buffer[this->start + this->buffered], this->capacity - this->start - this->buffered, 0);
+#endif
+                    if (moved > 0)
+                    {
+                        this->buffered += static_cast<size_t>(moved);
+                    }
+                    else if (moved == 0)
+                    {
+                        this->sourceOpen = false;
+                    }
+                    else if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    else if (kt::isWouldBlockError())
+                    {
+#ifdef __linux__
+                        this->stalled = this->buffered > 0;
+#endif
+                        break;
+                    }
+                    else
+                    {
+                        return this->failure();
+                    }
+                }
+                return kt::IOStatus::Complete;
+            }
+
+            /**
+             * Writes the held data to the destination until it is all written or the destination is full. Once the source has
+             * reached EOF and everything has been written the destination is shut down for writing, passing the half-close on.
+             */
+            kt::IOStatus drain()
+            {
+                while (this->buffered > 0)
+                {
+#ifdef __linux__
+                    const ssize_t written = ::splice(this->pipes[0], nullptr, this->destination, nullptr, this->buffered, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+#elif defined(_WIN32)
+                    const int written = ::send(this->destination, &this->buffer[this->start], static_cast<int>(this->buffered), 0);
+#else
+                    const ssize_t written = ::send(this->destination, &this->buffer[this->start], this->buffered, 0);
+#endif
+                    if (written > 0)
+                    {
+                        this->buffered -= static_cast<size_t>(written);
+                        this->counter += static_cast<uint64_t>(written);
+#ifdef __linux__
+                        this->stalled = false;
+#else
+                        this->start = this->buffered == 0 ? 0 : this->start + static_cast<size_t>(written);
+#endif
+                    }
+                    else if (written < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    else if (written == 0 || kt::isWouldBlockError())
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        return this->failure();
+                    }
+                }
+
+                if (!this->sourceOpen && this->buffered == 0 && !this->shutDown)
+                {
+#ifdef _WIN32
+                    ::shutdown(this->destination, SD_SEND);
+#else
+                    ::shutdown(this->destination, SHUT_WR);
+#endif
+                    this->shutDown = true;
+                }
+                return kt::IOStatus::Complete;
+            }
+        };
+
+        /**
+         * Reads the pending error of a socket that poll reported as failed or hung up while the relay had nothing to do on it.
+         *
+         * @return the status the relay should stop with, or *kt::IOStatus::Complete* if the socket has no pending error.
+         */
+        kt::IOStatus pendingError(const SOCKET& socket)
+        {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            if (::getsockopt(socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length) != 0)
+            {
+                return kt::IOStatus::Error;
+            }
+            if (error == 0)
+            {
+                return kt::IOStatus::Complete;
+            }
+
+#ifdef _WIN32
+            WSASetLastError(error);
+#else
+            errno = error;
+#endif
+            return kt::isConnectionClosedError() ? kt::IOStatus::Closed : kt::IOStatus::Error;
+        }
+    }
+
+    /**
+     * Moves data between two connected sockets in both directions until both have finished sending, for example to forward an
+     * accepted connection to an upstream server. On Linux the data is moved with *splice()* through a pipe per direction, so it is
+     * never copied into user space. Other platforms relay through a buffer per direction.
+     *
+     * When one side shuts down its sending half the other side is shut down for writing once everything before it has been
+     * delivered, while data keeps flowing in the opposite direction. Both sockets are put in non-blocking mode while relaying and
+     * returned to their previous mode afterwards. Neither socket is closed.
+     *
+     * @param a - One of the sockets to relay between.
+     * @param b - The other socket to relay between.
+     * @param counters - Updated with the amount of bytes delivered in each direction as they are delivered.
+     *
+     * @return *kt::IOStatus::Complete* once both sides have finished sending and all of their data has been delivered,
+     * *kt::IOStatus::Closed* if either connection was reset or *kt::IOStatus::Error* on any other failure.
+     */
+    kt::IOStatus relay(kt::ConnectionOrientedSocket& a, kt::ConnectionOrientedSocket& b, kt::RelayCounters& counters)
+    {
+        const bool aNonBlocking = a.isNonBlocking();
+        const bool bNonBlocking = b.isNonBlocking();
+        std::vector<RelayDirection> directions = { RelayDirection(a.getSocket(), b.getSocket(), counters.aToB), RelayDirection(b.getSocket(), a.getSocket(), counters.bToA) };
+
+        // Set once a socket is hung up without a pending error, it then only needs polling while the relay is waiting on it
+        bool hungUp[2] = { false, false };
+        kt::IOStatus status = kt::IOStatus::Complete;
+        if (!a.setNonBlocking(true) || !b.setNonBlocking(true) || !directions[0].open() || !directions[1].open())
+        {
+            status = kt::IOStatus::Error;
+        }
+
+        while (status == kt::IOStatus::Complete && !(directions[0].shutDown && directions[1].shutDown))
+        {
+            std::vector<pollfd> descriptors = { pollfd{ a.getSocket(), 0, 0 }, pollfd{ b.getSocket(), 0, 0 } };
+            for (size_t i = 0; i < directions.size(); i++)
+            {
+                if (directions[i].canFill())
+                {
+                    descriptors[i].events |= POLLIN;
+                }
+                if (directions[i].buffered > 0)
+                {
+                    descriptors[1 - i].events |= POLLOUT;
+                }
+            }
+            for (size_t i = 0; i < descriptors.size(); i++)
+            {
+                // Errors and hang ups are reported even when no events are requested, which would wake every poll straight away
+                const bool finished = !directions[i].sourceOpen && directions[1 - i].shutDown;
+                if (descriptors[i].events == 0 && (finished || hungUp[i]))
+                {
+                    descriptors[i].fd = kt::getInvalidSocketValue();
+                }
+            }
+
+#ifdef _WIN32
+            const int ready = WSAPoll(descriptors.data(), static_cast<ULONG>(descriptors.size()), -1);
+#else
+            const int ready = ::poll(descriptors.data(), descriptors.size(), -1);
+#endif
+            if (ready < 0)
+            {
+                if (errno != EINTR)
+                {
+                    status = kt::IOStatus::Error;
+                }
+                continue;
+            }
+            if ((descriptors[0].revents & POLLNVAL) != 0 || (descriptors[1].revents & POLLNVAL) != 0)
+            {
+                status = kt::IOStatus::Error;
+                continue;
+            }
+
+            // A socket with nothing to do can only be woken by an error or a hang up, such as a reset of a side that already
+            // half-closed. Neither fill() nor drain() would touch it, so the error is read here instead.
+            for (size_t i = 0; i < descriptors.size() && status == kt::IOStatus::Complete; i++)
+            {
+                if (descriptors[i].events == 0 && (descriptors[i].revents & (POLLERR | POLLHUP)) != 0)
+                {
+                    status = pendingError(descriptors[i].fd);
+                    if (status == kt::IOStatus::Complete && (descriptors[i].revents & POLLERR) != 0)
+                    {
+                        status = kt::IOStatus::Error;
+                    }
+                    hungUp[i] = true;
+                }
+            }
+            if (status != kt::IOStatus::Complete)
+            {
+                continue;
+            }
+
+            for (RelayDirection& direction : directions)
+            {
+                status = direction.fill();
+                if (status == kt::IOStatus::Complete)
+                {
+                    status = direction.drain();
+                }
+                if (status != kt::IOStatus::Complete)
+                {
+                    break;
+                }
+            }
+        }
+
+        for (RelayDirection& direction : directions)
+        {
+            direction.release();
+        }
+        a.setNonBlocking(aNonBlocking);
+        b.setNonBlocking(bNonBlocking);
+        return status;
+    }
+
+    /**
+     * Relays between the two sockets without reporting the amount of bytes moved.
+     * See *kt::relay(kt::ConnectionOrientedSocket&, kt::ConnectionOrientedSocket&, kt::RelayCounters&)*.
+     */
+    kt::IOStatus relay(kt::ConnectionOrientedSocket& a, kt::ConnectionOrientedSocket& b)
+    {
+        kt::RelayCounters counters;
+        return kt::relay(a, b, counters);
+    }
+}
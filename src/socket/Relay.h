@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ConnectionOrientedSocket.h"
+#include "../enums/IOStatus.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace kt
+{
+    /**
+     * The amount of bytes a *kt::relay()* has delivered in each direction. The counters are updated as data is delivered, so they
+     * can be read from another thread while the relay is running.
+     */
+    struct RelayCounters
+    {
+        std::atomic<uint64_t> aToB{0};
+        std::atomic<uint64_t> bToA{0};
+    };
+
+    kt::IOStatus relay(kt::ConnectionOrientedSocket&, kt::ConnectionOrientedSocket&, kt::RelayCounters&);
+    kt::IOStatus relay(kt::ConnectionOrientedSocket&, kt::ConnectionOrientedSocket&);
+}
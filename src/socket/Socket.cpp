@@ -1,6 +1,7 @@
 #include "Socket.h"
 #include "../socketexceptions/SocketException.hpp"
 #include "../socketexceptions/BindingException.hpp"
+#include "../socketexceptions/TimeoutException.hpp"
 #include "../socketexceptions/SocketError.h"
 
 #include <iostream>
@@ -10,6 +11,10 @@
 #include <sstream>
 #include <iomanip>
 #include <optional>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cerrno>
 
 #ifdef _WIN32
 
@@ -31,6 +36,8 @@
 #include <ifaddrs.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <poll.h>
+#include <fcntl.h>
 
 #endif
 
@@ -46,7 +53,6 @@ namespace kt
 			return -1;
 		}
 
-		fd_set sReady{};
 		timeval timeoutVal{};
 		if (timeOutVal == nullptr)
 		{
@@ -55,17 +61,305 @@ namespace kt
 			timeOutVal->tv_usec = timeout % 1000000;
 		}
 
+#ifdef _WIN32
+		fd_set sReady{};
 		FD_ZERO(&sReady);
 		FD_SET(socketDescriptor, &sReady);
 
 		// On windows: "Ignored. The nfds (the first arg) parameter is included only for compatibility with Berkeley sockets."
-		// On linux: "ndfs (the first arg) is the highest-numbered file descriptor in any of the three sets, plus 1."
-		// So we will use the linux required value since it is ignored in the windows API.
 		int result = select(static_cast<int>(socketDescriptor + 1), &sReady, nullptr, nullptr, timeOutVal);
+#else
+		// select() can only watch descriptors below FD_SETSIZE, anything larger would write past the end of the fd_set.
+		// poll() has no such limit, so the microsecond timeout is rounded up to the next millisecond and used instead.
+		pollfd descriptor{};
+		descriptor.fd = socketDescriptor;
+		descriptor.events = POLLIN;
+
+		const long milliseconds = (timeOutVal->tv_sec * 1000) + ((timeOutVal->tv_usec + 999) / 1000);
+		int result = poll(&descriptor, 1, static_cast<int>(milliseconds));
+
+		// select() reports a closed descriptor as an error, keep that behaviour so connected() still works
+		if (result > 0 && (descriptor.revents & POLLNVAL) != 0)
+		{
+			return -1;
+		}
+#endif
 		return result;
 	}
 
-	void Socket::close(SOCKET socket)
+	/**
+	 * Switches the provided socket between blocking and non-blocking mode.
+	 *
+	 * @return *true* if the mode was changed successfully.
+	 */
+	bool Socket::setNonBlocking(const SOCKET& socketDescriptor, const bool& nonBlocking) const
+	{
+#ifdef _WIN32
+		u_long mode = nonBlocking ? 1 : 0;
+		return ioctlsocket(socketDescriptor, FIONBIO, &mode) == 0;
+
+#else
+		int flags = fcntl(socketDescriptor, F_GETFL, 0);
+		if (flags == -1)
+		{
+			return false;
+		}
+		flags = nonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+		return fcntl(socketDescriptor, F_SETFL, flags) == 0;
+#endif
+	}
+
+	/**
+	 * @return *true* if the provided socket is in non-blocking mode. Windows does not expose this so it always returns *false*.
+	 */
+	bool Socket::isNonBlocking(const SOCKET& socketDescriptor) const
+	{
+#ifdef _WIN32
+		return false;
+
+#else
+		int flags = fcntl(socketDescriptor, F_GETFL, 0);
+		return flags != -1 && (flags & O_NONBLOCK) != 0;
+#endif
+	}
+
+	/**
+	 * Reads and clears the pending error on the provided socket, for example the result of a non-blocking *connect()*.
+	 *
+	 * @return the pending error code, 0 if there is none, or -1 if it could not be read.
+	 */
+	int Socket::getSocketError(const SOCKET& socketDescriptor) const
+	{
+		int error = 0;
+		socklen_t length = sizeof(error);
+		if (getsockopt(socketDescriptor, SOL_SOCKET, SO_ERROR, (char*)&error, &length) != 0)
+		{
+			return -1;
+		}
+		return error;
+	}
+
+	/**
+	 * Waits for the provided socket to become writable, which is also how a non-blocking *connect()* reports that it has finished.
+	 *
+	 * @param timeout - The amount of microseconds to wait, a negative value waits indefinitely.
+	 *
+	 * @return a positive value if the socket is writable or has an error pending, 0 if the timeout elapsed, or -1 if the wait failed.
+	 */
+	int Socket::pollSocketWritable(const SOCKET& socketDescriptor, const long& timeout) const
+	{
+		if (kt::isInvalidSocket(socketDescriptor))
+		{
+			return -1;
+		}
+
+		pollfd descriptor{};
+		descriptor.fd = socketDescriptor;
+		descriptor.events = POLLOUT;
+		const int milliseconds = timeout < 0 ? -1 : static_cast<int>((timeout + 999) / 1000);
+
+#ifdef _WIN32
+		int result = WSAPoll(&descriptor, 1, milliseconds);
+#else
+		int result = poll(&descriptor, 1, milliseconds);
+#endif
+		if (result > 0 && (descriptor.revents & POLLNVAL) != 0)
+		{
+			return -1;
+		}
+		return result;
+	}
+
+	/**
+	 * Connects the provided socket without waiting longer than the timeout. The connection is started in non-blocking mode, the
+	 * socket is polled for writability and the outcome is read from *SO_ERROR*. The socket is returned to blocking mode afterwards.
+	 * Unix domain sockets whose listener backlog is full are retried until the timeout elapses.
+	 *
+	 * @param timeout - The amount of microseconds to wait for the connection, 0 or less performs a regular blocking *connect()*.
+	 *
+	 * @return 0 if the socket connected, 1 if the timeout elapsed first, or -1 if the connection failed. On failure *errno* describes
+	 * the reason.
+	 */
+	int Socket::connectSocket(const SOCKET& socketDescriptor, const sockaddr* address, const socklen_t& addressLength, const long& timeout) const
+	{
+		if (timeout <= 0)
+		{
+			return ::connect(socketDescriptor, address, addressLength) == 0 ? 0 : -1;
+		}
+
+		if (!this->setNonBlocking(socketDescriptor, true))
+		{
+			return -1;
+		}
+
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+		std::chrono::microseconds retryDelay(100);
+		int result = -1;
+		while (true)
+		{
+			if (::connect(socketDescriptor, address, addressLength) == 0)
+			{
+				result = 0;
+				break;
+			}
+
+			const long remaining = static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count());
+			if (kt::isConnectInProgressError())
+			{
+				const int ready = this->pollSocketWritable(socketDescriptor, std::max(0L, remaining));
+				if (ready == 0)
+				{
+					result = 1;
+				}
+				else if (ready > 0)
+				{
+					const int error = this->getSocketError(socketDescriptor);
+					result = error == 0 ? 0 : -1;
+					if (error > 0)
+					{
+						errno = error;
+					}
+				}
+				break;
+			}
+			else if (kt::isWouldBlockError())
+			{
+				// A unix domain listener with a full backlog refuses non-blocking connections outright rather than queueing them
+				if (remaining <= 0)
+				{
+					result = 1;
+					break;
+				}
+				std::this_thread::sleep_for(std::min(retryDelay, std::chrono::microseconds(remaining)));
+				retryDelay = std::min(retryDelay * 2, std::chrono::microseconds(10000));
+				continue;
+			}
+			break;
+		}
+
+		// Keep errno describing the connection failure rather than the mode change
+		const int error = errno;
+		this->setNonBlocking(socketDescriptor, false);
+		errno = error;
+		return result;
+	}
+
+	/**
+	 * Accepts a single connection from the listening socket, creating it with the requested flags in the same call where supported.
+	 *
+	 * @return the accepted socket, or an invalid socket if nothing could be accepted or the flags could not be applied.
+	 */
+	SOCKET Socket::acceptSocket(const SOCKET& listener, sockaddr* address, socklen_t* addressLength, const bool& nonBlocking, const bool& closeOnExec) const
+	{
+#ifdef __linux__
+		return ::accept4(listener, address, addressLength, (nonBlocking ? SOCK_NONBLOCK : 0) | (closeOnExec ? SOCK_CLOEXEC : 0));
+#else
+		SOCKET accepted = ::accept(listener, address, addressLength);
+		if (kt::isInvalidSocket(accepted))
+		{
+			return accepted;
+		}
+
+		bool applied = !nonBlocking || this->setNonBlocking(accepted, true);
+#ifndef _WIN32
+		applied = applied && (!closeOnExec || fcntl(accepted, F_SETFD, FD_CLOEXEC) != -1);
+#endif
+		if (!applied)
+		{
+			this->close(accepted);
+			return kt::getInvalidSocketValue();
+		}
+		return accepted;
+#endif
+	}
+
+	/**
+	 * Waits once for a connection and then accepts every connection already queued on the listening socket, up to the maximum.
+	 * A non-blocking listener is drained by accepting until the queue reports it would block. A blocking listener is instead polled
+	 * without waiting before each further accept, since its mode is shared with every other thread using it and is never changed.
+	 * Another thread can still take the last queued connection between that poll and the accept, in which case the accept blocks
+	 * until the next connection arrives, so use a non-blocking listener when it is shared between threads.
+	 *
+	 * @param timeout - The amount of microseconds to wait for the first connection, 0 waits until one arrives.
+	 * @param onAccepted - Called with each accepted socket and its remote address. If it throws the socket is closed.
+	 *
+	 * @return the amount of connections accepted.
+	 *
+	 * @throw TimeoutException - If no connection arrives within the timeout.
+	 * @throw SocketException - If no connection could be accepted.
+	 */
+	size_t Socket::acceptSockets(const SOCKET& listener, const unsigned int& max, const long& timeout, const bool& nonBlocking, const bool& closeOnExec, const std::function<void(const SOCKET&, const sockaddr_storage&)>& onAccepted) const
+	{
+		if (max == 0)
+		{
+			return 0;
+		}
+
+		if (timeout > 0)
+		{
+			int res = this->pollSocket(listener, timeout);
+			if (res == -1)
+			{
+				throw kt::SocketException("Failed to poll as socket is no longer valid: " + kt::getErrorCode());
+			}
+			else if (res == 0)
+			{
+				throw kt::TimeoutException("No applicable connections could be accepted during the time period specified " + std::to_string(timeout) + " microseconds.");
+			}
+		}
+
+		size_t accepted = 0;
+		std::string error;
+		const bool listenerNonBlocking = this->isNonBlocking(listener);
+		while (accepted < max)
+		{
+			// Only drain what is already queued, a blocking listener would otherwise wait for the next connection
+			if (accepted > 0 && !listenerNonBlocking && this->pollSocket(listener, 0) <= 0)
+			{
+				break;
+			}
+
+			sockaddr_storage address{};
+			socklen_t addressLength = sizeof(address);
+			SOCKET socket = this->acceptSocket(listener, reinterpret_cast<sockaddr*>(&address), &addressLength, nonBlocking, closeOnExec);
+			if (!kt::isInvalidSocket(socket))
+			{
+				try
+				{
+					onAccepted(socket, address);
+				}
+				catch (...)
+				{
+					this->close(socket);
+					throw;
+				}
+				accepted++;
+				continue;
+			}
+
+			if (kt::isWouldBlockError())
+			{
+				break;
+			}
+#ifndef _WIN32
+			// The connection was reset before it could be accepted, the rest of the queue is unaffected
+			if (errno == ECONNABORTED || errno == EINTR)
+			{
+				continue;
+			}
+#endif
+			error = kt::getErrorCode();
+			break;
+		}
+
+		if (accepted == 0 && !error.empty())
+		{
+			throw kt::SocketException("Failed to accept connection: " + error);
+		}
+		return accepted;
+	}
+
+	void Socket::close(SOCKET socket) const
 	{
 #ifdef _WIN32
 		closesocket(socket);
@@ -11,6 +11,7 @@
 #endif
 
 #include <WinSock2.h>
+#include <ws2tcpip.h>
 
 #else
 
@@ -22,13 +23,22 @@ typedef int SOCKET;
 
 #endif
 
+#include <functional>
+
 namespace kt
 {
 	class Socket
 	{
 		protected:
 			int pollSocket(const SOCKET& socketDescriptor, const long& timeout, timeval* timeOutVal = nullptr) const;
-			void close(SOCKET socket);
+			void close(SOCKET socket) const;
+			bool setNonBlocking(const SOCKET&, const bool&) const;
+			bool isNonBlocking(const SOCKET&) const;
+			int getSocketError(const SOCKET&) const;
+			int pollSocketWritable(const SOCKET&, const long&) const;
+			int connectSocket(const SOCKET&, const sockaddr*, const socklen_t&, const long&) const;
+			SOCKET acceptSocket(const SOCKET&, sockaddr*, socklen_t*, const bool&, const bool&) const;
+			size_t acceptSockets(const SOCKET&, const unsigned int&, const long&, const bool&, const bool&, const std::function<void(const SOCKET&, const sockaddr_storage&)>&) const;
 		
 		public:
 			virtual void close() = 0;
@@ -1,9 +1,19 @@
 
 #include "TCPSocket.h"
 #include "../socketexceptions/SocketException.hpp"
+#include "../socketexceptions/TimeoutException.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
 #include <cstring>
 
+#ifndef _WIN32
+
+#include <poll.h>
+
+#endif
+
 namespace kt
 {
 	TCPSocket::TCPSocket(const std::string& hostname, const unsigned short& port, const kt::InternetProtocolVersion protocolVersion)
@@ -15,6 +25,35 @@ namespace kt
 		constructSocket();
 	}
 
+	/**
+	 * TCPSocket constructor that races connection attempts to the resolved addresses (RFC 8305 "Happy Eyeballs").
+	 * The addresses are ordered alternating between IPV6 and IPV4, and a new non-blocking attempt is started every *attemptDelay*
+	 * microseconds (or as soon as an attempt fails) while the earlier ones are still in flight. The first attempt to connect is kept
+	 * and all others are closed.
+	 *
+	 * @param timeout - The overall amount of microseconds to wait for a connection, 0 or less waits until every attempt has failed.
+	 * @param attemptDelay - The amount of microseconds to wait for an attempt before starting the next one in parallel.
+	 * @param attemptTimeout - The amount of microseconds after which a single attempt is abandoned, 0 or less leaves it running
+	 * until the overall timeout.
+	 *
+	 * @throw TimeoutException - If no attempt connected within the timeout.
+	 * @throw SocketException - If the hostname cannot be resolved or every attempt failed.
+	 */
+	TCPSocket::TCPSocket(const std::string& hostname, const unsigned short& port, const kt::InternetProtocolVersion protocolVersion, const long& timeout, const long& attemptDelay, const long& attemptTimeout)
+	{
+		this->hostname = hostname;
+		this->port = port;
+		this->protocolVersion = protocolVersion;
+
+		constructSocket(timeout, attemptDelay, attemptTimeout);
+	}
+
+	/**
+	 * TCPSocket constructor for an already connected socket, such as one returned by *accept()*.
+	 *
+	 * @param hostname - The remote hostname. When empty, *getHostname()* formats the address from *acceptedAddress* on demand instead,
+	 * so connections whose hostname is never read do not pay for it.
+	 */
 	TCPSocket::TCPSocket(const SOCKET& socket, const std::string& hostname, const unsigned short& port, const kt::InternetProtocolVersion protocolVersion, const kt::SocketAddress& acceptedAddress)
 	{
 		this->socketDescriptor = socket;
@@ -26,6 +65,24 @@ namespace kt
 
     TCPSocket::TCPSocket(const kt::SocketAddress address)
     {
+		constructSocket(address, 0);
+    }
+
+	/**
+	 * TCPSocket constructor that connects to the provided address without waiting longer than the timeout.
+	 *
+	 * @param timeout - The amount of microseconds to wait for the connection to be established.
+	 *
+	 * @throw TimeoutException - If the connection was not established within the timeout.
+	 * @throw SocketException - If the connection was refused or failed.
+	 */
+	TCPSocket::TCPSocket(const kt::SocketAddress& address, const long& timeout)
+	{
+		constructSocket(address, timeout);
+	}
+
+	void TCPSocket::constructSocket(const kt::SocketAddress& address, const long& timeout)
+	{
 		std::optional<std::string> resolvedHostname = kt::getAddress(address);
 		this->hostname = resolvedHostname.value_or("");
 		this->port = kt::getPortNumber(address);
@@ -38,17 +95,22 @@ namespace kt
 			throw kt::SocketException("Unable to construct socket to provided addresses with hostname [" + this->hostname + ":" + std::to_string(this->port) + "] " + getErrorCode());
 		}
 
-		int connectionResult = connect(this->socketDescriptor, &address.address, sizeof(address));
+		int connectionResult = Socket::connectSocket(this->socketDescriptor, &address.address, sizeof(address), timeout);
 		if (connectionResult == 0)
 		{
 			this->serverAddress = address;
 			this->protocolVersion = static_cast<kt::InternetProtocolVersion>(address.address.sa_family);
+			return;
 		}
-		else
+
+		const std::string error = getErrorCode();
+		this->close();
+		if (connectionResult == 1)
 		{
-			throw kt::SocketException("Unable to connect to provided address with hostname [" + this->hostname + ":" + std::to_string(this->port) + "] " + getErrorCode());
+			throw kt::TimeoutException("Unable to connect to provided address with hostname [" + this->hostname + ":" + std::to_string(this->port) + "] within " + std::to_string(timeout) + " microseconds.");
 		}
-    }
+		throw kt::SocketException("Unable to connect to provided address with hostname [" + this->hostname + ":" + std::to_string(this->port) + "] " + error);
+	}
 
     TCPSocket::TCPSocket(const kt::TCPSocket& socket)
 	{
@@ -70,6 +132,99 @@ namespace kt
 		return *this;
 	}
 
+	/**
+	 * Exception-free connecting constructor. Resolves the hostname and connects to the resolved addresses in order.
+	 *
+	 * @param timeout - The amount of microseconds all connection attempts together may take, 0 uses blocking connects.
+	 *
+	 * @return the connected socket, or *Resolve*, *Timeout* or *System* if no connection could be made.
+	 */
+	kt::Result<kt::TCPSocket> TCPSocket::tryConnect(const std::string& hostname, const unsigned short& port, const kt::InternetProtocolVersion protocolVersion, const long& timeout) noexcept
+	{
+#ifdef _WIN32
+		WSADATA wsaData{};
+		if (int res = WSAStartup(MAKEWORD(2, 2), &wsaData); res != 0)
+		{
+			return kt::Result<kt::TCPSocket>(kt::ResultError::System, res);
+		}
+
+#endif
+
+		addrinfo hints = kt::createTcpHints(protocolVersion);
+		std::pair<std::vector<kt::SocketAddress>, int> addresses = kt::resolveToAddresses(hostname, port, hints);
+		if (addresses.second != 0 || addresses.first.empty())
+		{
+			return kt::Result<kt::TCPSocket>(kt::ResultError::Resolve, addresses.second);
+		}
+
+		kt::TCPSocket socket(kt::getInvalidSocketValue(), hostname, port, protocolVersion, kt::SocketAddress{});
+		std::pair<kt::ResultError, int> result = socket.tryConstructSocket(addresses.first, timeout);
+		if (result.first != kt::ResultError::None)
+		{
+			return kt::Result<kt::TCPSocket>(result.first, result.second);
+		}
+		return kt::Result<kt::TCPSocket>(std::move(socket));
+	}
+
+	/**
+	 * Exception-free version of *TCPSocket(const kt::SocketAddress&, const long&)*.
+	 *
+	 * @return the connected socket, or *Timeout* or *System* if the connection could not be made.
+	 */
+	kt::Result<kt::TCPSocket> TCPSocket::tryConnect(const kt::SocketAddress& address, const long& timeout) noexcept
+	{
+		kt::TCPSocket socket(kt::getInvalidSocketValue(), std::string(), static_cast<unsigned short>(kt::getPortNumber(address)), kt::getInternetProtocolVersion(address), kt::SocketAddress{});
+		std::pair<kt::ResultError, int> result = socket.tryConstructSocket(std::vector<kt::SocketAddress>{ address }, timeout);
+		if (result.first != kt::ResultError::None)
+		{
+			return kt::Result<kt::TCPSocket>(result.first, result.second);
+		}
+		return kt::Result<kt::TCPSocket>(std::move(socket));
+	}
+
+	/**
+	 * Connects to each address in turn until one succeeds, sharing the timeout between the attempts.
+	 *
+	 * @return *None* once connected, otherwise the error of the last attempt and its error code.
+	 */
+	std::pair<kt::ResultError, int> TCPSocket::tryConstructSocket(const std::vector<kt::SocketAddress>& addresses, const long& timeout) noexcept
+	{
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+		std::pair<kt::ResultError, int> result = std::make_pair(kt::ResultError::System, 0);
+		addrinfo hints = kt::createTcpHints();
+		for (const kt::SocketAddress& address : addresses)
+		{
+			long remaining = 0;
+			if (timeout > 0)
+			{
+				remaining = static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count());
+				if (remaining <= 0)
+				{
+					return std::make_pair(kt::ResultError::Timeout, 0);
+				}
+			}
+
+			this->socketDescriptor = socket(address.address.sa_family, hints.ai_socktype, hints.ai_protocol);
+			if (isInvalidSocket(this->socketDescriptor))
+			{
+				result = std::make_pair(kt::ResultError::System, kt::getLastError());
+				continue;
+			}
+
+			const int connectionResult = Socket::connectSocket(this->socketDescriptor, &address.address, sizeof(address), remaining);
+			if (connectionResult == 0)
+			{
+				this->serverAddress = address;
+				this->protocolVersion = static_cast<kt::InternetProtocolVersion>(address.address.sa_family);
+				return std::make_pair(kt::ResultError::None, 0);
+			}
+
+			result = connectionResult == 1 ? std::make_pair(kt::ResultError::Timeout, 0) : std::make_pair(kt::ResultError::System, kt::getLastError());
+			this->close();
+		}
+		return result;
+	}
+
 	void TCPSocket::constructSocket()
 	{
 #ifdef _WIN32
@@ -112,6 +267,198 @@ namespace kt
 		throw kt::SocketException("Unable to connect to resolved addresses for provided hostname [" + this->hostname + ":" + std::to_string(this->port) + "] " + getErrorCode());
 	}
 
+	void TCPSocket::constructSocket(const long& timeout, const long& attemptDelay, const long& attemptTimeout)
+	{
+#ifdef _WIN32
+		WSADATA wsaData{};
+		if (int res = WSAStartup(MAKEWORD(2, 2), &wsaData); res != 0)
+		{
+			throw kt::SocketException("WSAStartup Failed. " + std::to_string(res));
+		}
+
+#endif
+
+		typedef std::chrono::steady_clock Clock;
+		struct Attempt
+		{
+			SOCKET socket;
+			kt::SocketAddress address;
+			Clock::time_point expiry;
+		};
+
+		addrinfo hints = kt::createTcpHints(this->protocolVersion);
+		std::pair<std::vector<kt::SocketAddress>, int> addresses = kt::resolveToAddresses(this->hostname, this->port, hints);
+		if (addresses.second != 0 || addresses.first.empty())
+		{
+			throw kt::SocketException("Unable to resolve IP of destination address with hostname: [" + this->hostname + ":" + std::to_string(this->port) + "]. Look up response code: [" + std::to_string(addresses.second) + "]. " + getErrorCode());
+		}
+
+		// Keep the resolver's preference within each family but alternate between families, starting with the preferred one
+		std::vector<kt::SocketAddress> ordered;
+		std::vector<kt::SocketAddress> otherFamily;
+		for (const kt::SocketAddress& address : addresses.first)
+		{
+			(address.address.sa_family == addresses.first.front().address.sa_family ? ordered : otherFamily).push_back(address);
+		}
+		for (size_t i = 0; i < otherFamily.size(); i++)
+		{
+			ordered.insert(ordered.begin() + std::min(ordered.size(), (i * 2) + 1), otherFamily[i]);
+		}
+
+		const Clock::time_point start = Clock::now();
+		const Clock::time_point deadline = start + std::chrono::microseconds(timeout > 0 ? timeout : 0);
+		Clock::time_point nextAttempt = start;
+		std::vector<Attempt> pending;
+		std::string lastError = "";
+		size_t nextAddress = 0;
+
+		const auto closePending = [this, &pending]()
+		{
+			for (const Attempt& attempt : pending)
+			{
+				Socket::close(attempt.socket);
+			}
+			pending.clear();
+		};
+
+		while (true)
+		{
+			Clock::time_point now = Clock::now();
+			if (timeout > 0 && now >= deadline)
+			{
+				closePending();
+				throw kt::TimeoutException("Unable to connect to resolved addresses for provided hostname [" + this->hostname + ":" + std::to_string(this->port) + "] within " + std::to_string(timeout) + " microseconds.");
+			}
+
+			// Expired attempts are dropped so that the next address is tried straight away
+			for (size_t i = 0; i < pending.size();)
+			{
+				if (attemptTimeout > 0 && now >= pending[i].expiry)
+				{
+					Socket::close(pending[i].socket);
+					pending.erase(pending.begin() + i);
+					lastError = "Connection attempt timed out.";
+					nextAttempt = now;
+				}
+				else
+				{
+					i++;
+				}
+			}
+
+			if (nextAddress < ordered.size() && (pending.empty() || now >= nextAttempt))
+			{
+				const kt::SocketAddress& address = ordered[nextAddress++];
+				SOCKET attempt = socket(address.address.sa_family, hints.ai_socktype, hints.ai_protocol);
+				if (isInvalidSocket(attempt) || !Socket::setNonBlocking(attempt, true))
+				{
+					lastError = getErrorCode();
+					if (!isInvalidSocket(attempt))
+					{
+						Socket::close(attempt);
+					}
+					continue;
+				}
+
+				if (connect(attempt, &address.address, kt::getAddressLength(address)) == 0)
+				{
+					closePending();
+					pending.push_back(Attempt{ attempt, address, now });
+					break;
+				}
+				else if (!isConnectInProgressError())
+				{
+					lastError = getErrorCode();
+					Socket::close(attempt);
+					continue;
+				}
+
+				pending.push_back(Attempt{ attempt, address, now + std::chrono::microseconds(attemptTimeout > 0 ? attemptTimeout : 0) });
+				nextAttempt = now + std::chrono::microseconds(attemptDelay > 0 ? attemptDelay : 0);
+			}
+
+			if (pending.empty())
+			{
+				throw kt::SocketException("Unable to connect to resolved addresses for provided hostname [" + this->hostname + ":" + std::to_string(this->port) + "] " + lastError);
+			}
+
+			// Sleep until an attempt completes, the next attempt is due, an attempt expires or the overall deadline passes
+			Clock::time_point wakeUp = Clock::time_point::max();
+			if (timeout > 0)
+			{
+				wakeUp = deadline;
+			}
+			if (nextAddress < ordered.size())
+			{
+				wakeUp = std::min(wakeUp, nextAttempt);
+			}
+			std::vector<pollfd> descriptors;
+			for (const Attempt& attempt : pending)
+			{
+				if (attemptTimeout > 0)
+				{
+					wakeUp = std::min(wakeUp, attempt.expiry);
+				}
+				descriptors.push_back(pollfd{ attempt.socket, POLLOUT, 0 });
+			}
+
+			int waitMilliseconds = -1;
+			if (wakeUp != Clock::time_point::max())
+			{
+				const long long remaining = std::chrono::duration_cast<std::chrono::microseconds>(wakeUp - now).count();
+				waitMilliseconds = static_cast<int>(std::max(0LL, (remaining + 999) / 1000));
+			}
+
+#ifdef _WIN32
+			int ready = WSAPoll(descriptors.data(), static_cast<ULONG>(descriptors.size()), waitMilliseconds);
+#else
+			int ready = poll(descriptors.data(), descriptors.size(), waitMilliseconds);
+#endif
+			if (ready < 0 && errno != EINTR)
+			{
+				closePending();
+				throw kt::SocketException("Failed to wait for connection attempts to [" + this->hostname + ":" + std::to_string(this->port) + "] " + getErrorCode());
+			}
+
+			SOCKET connected = getInvalidSocketValue();
+			for (size_t i = descriptors.size(); i-- > 0 && ready > 0;)
+			{
+				if (descriptors[i].revents == 0)
+				{
+					continue;
+				}
+
+				const int error = Socket::getSocketError(descriptors[i].fd);
+				if (error == 0)
+				{
+					connected = descriptors[i].fd;
+					std::swap(pending[i], pending.back());
+					break;
+				}
+
+				lastError = std::strerror(error);
+				Socket::close(pending[i].socket);
+				pending.erase(pending.begin() + i);
+				nextAttempt = now;
+			}
+
+			if (!isInvalidSocket(connected))
+			{
+				break;
+			}
+		}
+
+		// The winner is always the last pending attempt at this point
+		const Attempt winner = pending.back();
+		pending.pop_back();
+		closePending();
+
+		Socket::setNonBlocking(winner.socket, false);
+		this->socketDescriptor = winner.socket;
+		this->serverAddress = winner.address;
+		this->protocolVersion = static_cast<kt::InternetProtocolVersion>(winner.address.address.sa_family);
+	}
+
 	void TCPSocket::close()
 	{
 		Socket::close(this->socketDescriptor);
@@ -125,7 +472,14 @@ namespace kt
 
     std::string TCPSocket::getHostname() const
     {
-		return this->hostname;
+		if (!this->hostname.empty())
+		{
+			return this->hostname;
+		}
+
+		// Accepted sockets only keep the remote address, see the accepting constructor
+		char formatted[INET6_ADDRSTRLEN];
+		return std::string(formatted, kt::formatAddress(this->serverAddress, formatted, sizeof(formatted)));
 	}
 
 	unsigned short TCPSocket::getPort() const
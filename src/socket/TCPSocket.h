@@ -8,6 +8,7 @@
 #include "../enums/InternetProtocolVersion.h"
 #include "../address/SocketAddress.h"
 #include "../socketexceptions/SocketError.h"
+#include "../socketexceptions/Result.h"
 #include "ConnectionOrientedSocket.h"
 
 #include "Socket.h"
@@ -48,16 +49,24 @@ namespace kt
 			kt::SocketAddress serverAddress = {}; // The remote address that we will be connected to
 
 			void constructSocket();
+			void constructSocket(const long&, const long&, const long&);
+			void constructSocket(const kt::SocketAddress&, const long&);
+			std::pair<kt::ResultError, int> tryConstructSocket(const std::vector<kt::SocketAddress>&, const long&) noexcept;
 
 		public:
 			TCPSocket() = delete;
 			TCPSocket(const std::string&, const unsigned short&, const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any);
+			TCPSocket(const std::string&, const unsigned short&, const kt::InternetProtocolVersion, const long&, const long& = 250000, const long& = 0);
 			TCPSocket(const SOCKET&, const std::string&, const unsigned short&, const kt::InternetProtocolVersion, const kt::SocketAddress&);
 			TCPSocket(const kt::SocketAddress);
+			TCPSocket(const kt::SocketAddress&, const long&);
 
 			TCPSocket(const kt::TCPSocket&);
 			kt::TCPSocket& operator=(const kt::TCPSocket&);
 
+			static kt::Result<kt::TCPSocket> tryConnect(const std::string&, const unsigned short&, const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any, const long& = 0) noexcept;
+			static kt::Result<kt::TCPSocket> tryConnect(const kt::SocketAddress&, const long& = 0) noexcept;
+
 			SOCKET getSocket() const override;
             std::string getHostname() const;
 			unsigned short getPort() const;
@@ -3,6 +3,8 @@
 #include "../socketexceptions/SocketException.hpp"
 #include "../socketexceptions/BindingException.hpp"
 
+#include <algorithm>
+
 namespace kt
 {
 	UDPSocket::UDPSocket(const kt::UDPSocket& socket)
@@ -11,6 +13,12 @@ namespace kt
 		this->receiveSocket = socket.receiveSocket;
 		this->listeningPort = socket.listeningPort;
 		this->protocolVersion = socket.protocolVersion;
+		this->cacheSendSockets = socket.cacheSendSockets;
+		this->sendSocketIPV4 = socket.sendSocketIPV4;
+		this->sendSocketIPV6 = socket.sendSocketIPV6;
+		this->connectedSocket = socket.connectedSocket;
+		this->connectedAddress = socket.connectedAddress;
+		this->connectionGeneration = socket.connectionGeneration;
 
 #ifdef _WIN32
 		WSADATA wsaData{};
@@ -28,6 +36,12 @@ namespace kt
 		this->receiveSocket = socket.receiveSocket;
 		this->listeningPort = socket.listeningPort;
 		this->protocolVersion = socket.protocolVersion;
+		this->cacheSendSockets = socket.cacheSendSockets;
+		this->sendSocketIPV4 = socket.sendSocketIPV4;
+		this->sendSocketIPV6 = socket.sendSocketIPV6;
+		this->connectedSocket = socket.connectedSocket;
+		this->connectedAddress = socket.connectedAddress;
+		this->connectionGeneration = socket.connectionGeneration;
 
 		return *this;
 	}
@@ -63,6 +77,46 @@ namespace kt
 		return bind(firstAddress, preBindSocketOperation);
 	}
 
+	/**
+	 * Exception-free version of *bind(const kt::InternetProtocolVersion, const std::optional<std::string>&, const unsigned short&)*.
+	 *
+	 * @return the bound address, or *Resolve* or *System* along with the error code if the socket could not be bound.
+	 */
+	kt::Result<kt::SocketAddress> UDPSocket::tryBind(const kt::InternetProtocolVersion protocolVersion, const std::optional<std::string>& localHostname, const unsigned short& port) noexcept
+	{
+#ifdef _WIN32
+		WSADATA wsaData{};
+		if (int res = WSAStartup(MAKEWORD(2, 2), &wsaData); res != 0)
+		{
+			return kt::Result<kt::SocketAddress>(kt::ResultError::System, res);
+		}
+
+#endif
+
+		addrinfo hints = kt::createUdpHints(protocolVersion, AI_PASSIVE);
+		std::pair<std::vector<kt::SocketAddress>, int> resolvedAddresses = kt::resolveToAddresses(localHostname.has_value() ? localHostname.value().c_str() : kt::getLocalAddress(protocolVersion), port, hints);
+		if (resolvedAddresses.second != 0 || resolvedAddresses.first.empty())
+		{
+			return kt::Result<kt::SocketAddress>(kt::ResultError::Resolve, resolvedAddresses.second);
+		}
+
+		try
+		{
+			std::pair<int, kt::SocketAddress> result = this->bind(resolvedAddresses.first.front());
+			if (result.first == -1)
+			{
+				const int error = kt::getLastError();
+				this->close();
+				return kt::Result<kt::SocketAddress>(kt::ResultError::System, error);
+			}
+			return kt::Result<kt::SocketAddress>(result.second);
+		}
+		catch (const kt::SocketException&)
+		{
+			return kt::Result<kt::SocketAddress>(kt::ResultError::System, kt::getLastError());
+		}
+	}
+
     std::pair<int, kt::SocketAddress> UDPSocket::bind(const std::optional<kt::SocketAddress> &addressOpt, const std::optional<std::function<void(SOCKET &)>> &preBindSocketOperation)
     {
 		if (!addressOpt.has_value())
@@ -114,6 +168,9 @@ namespace kt
 		return std::make_pair(bindResult, address);
     }
 
+    /**
+	 * Closes the receiving socket along with any cached send sockets and the connected socket.
+	 */
     void UDPSocket::close()
 	{
 		Socket::close(this->receiveSocket);
@@ -121,6 +178,9 @@ namespace kt
 		
 		this->bound = false;
 		this->listeningPort = std::nullopt;
+
+		this->closeSendSockets();
+		this->disconnect();
 	}
 
 	bool UDPSocket::ready(const unsigned long timeout) const
@@ -140,17 +200,28 @@ namespace kt
 		return this->sendTo(address, &message[0], message.size(), flags);
 	}
 
+	/**
+	 * Sends the provided buffer to the provided address. When send socket caching is enabled the socket for the address family
+	 * is reused between calls, otherwise a temporary socket is created and closed for this message.
+	 *
+	 * @return the result of the call to sendto(), or -2 if a socket could not be created.
+	 */
 	int UDPSocket::sendTo(const kt::SocketAddress& address, const char* buffer, const int& bufferLength, const int& flags)
 	{
-		SOCKET tempSocket = socket(address.address.sa_family, SOCK_DGRAM, IPPROTO_UDP);
-		if (kt::isInvalidSocket(tempSocket))
+		if (this->cacheSendSockets)
 		{
-			return -2;
+			SOCKET sendSocket = this->getSendSocket(address.address.sa_family);
+			if (kt::isInvalidSocket(sendSocket))
+			{
+				return -2;
+			}
+			return ::sendto(sendSocket, buffer, bufferLength, flags, &(address.address), kt::getAddressLength(address));
 		}
 
-		if (preSendSocketOperation.has_value())
+		SOCKET tempSocket = this->createSendSocket(address.address.sa_family);
+		if (kt::isInvalidSocket(tempSocket))
 		{
-			preSendSocketOperation.value()(tempSocket);
+			return -2;
 		}
 
 		int result = ::sendto(tempSocket, buffer, bufferLength, flags, &(address.address), kt::getAddressLength(address));
@@ -176,6 +247,114 @@ namespace kt
 		return std::make_pair(result, firstAddress);
 	}
 
+	int UDPSocket::sendBatch(std::vector<kt::UDPSendMessage>& messages, const int& flags)
+	{
+		return this->sendBatch(messages.data(), messages.size(), flags);
+	}
+
+	/**
+	 * Sends each of the provided messages to its own address. On Linux consecutive messages of the same address family are handed
+	 * to the kernel together with sendmmsg(), other platforms fall back to one sendto() per message.
+	 * The send socket follows the same rules as *sendTo()*, so enabling send socket caching avoids creating a socket per batch.
+	 *
+	 * @param messages - The messages to send, each message's *result* is updated with the outcome of its send.
+	 * @param messageCount - The amount of messages pointed to by *messages*.
+	 *
+	 * @return the amount of messages that were sent successfully.
+	 */
+	int UDPSocket::sendBatch(kt::UDPSendMessage* messages, const size_t& messageCount, const int& flags)
+	{
+		int sentMessages = 0;
+		size_t index = 0;
+		while (index < messageCount)
+		{
+			const int addressFamily = messages[index].address.address.sa_family;
+			size_t runEnd = index + 1;
+			while (runEnd < messageCount && messages[runEnd].address.address.sa_family == addressFamily)
+			{
+				runEnd++;
+			}
+
+			SOCKET sendSocket = this->cacheSendSockets ? this->getSendSocket(addressFamily) : this->createSendSocket(addressFamily);
+			if (kt::isInvalidSocket(sendSocket))
+			{
+				for (size_t i = index; i < runEnd; i++)
+				{
+					messages[i].result = -1;
+				}
+			}
+			else
+			{
+				sentMessages += this->sendBatchToSocket(sendSocket, &messages[index], runEnd - index, flags);
+				if (!this->cacheSendSockets)
+				{
+					Socket::close(sendSocket);
+				}
+			}
+			index = runEnd;
+		}
+		return sentMessages;
+	}
+
+	int UDPSocket::sendBatchToSocket(const SOCKET& sendSocket, kt::UDPSendMessage* messages, const size_t& messageCount, const int& flags)
+	{
+		int sentMessages = 0;
+#ifdef __linux__
+		// The kernel will not accept more than UIO_MAXIOV messages in a single call
+		const size_t maximumBatchSize = 1024;
+		const size_t batchCapacity = std::min(messageCount, maximumBatchSize);
+		if (this->sendMessageHeaders.size() < batchCapacity)
+		{
+			this->sendMessageHeaders.resize(batchCapacity);
+			this->sendVectors.resize(batchCapacity);
+		}
+
+		size_t sent = 0;
+		while (sent < messageCount)
+		{
+			const size_t batchSize = std::min(messageCount - sent, maximumBatchSize);
+			for (size_t i = 0; i < batchSize; i++)
+			{
+				kt::UDPSendMessage& message = messages[sent + i];
+				this->sendVectors[i].iov_base = const_cast<char*>(message.buffer);
+				this->sendVectors[i].iov_len = message.length;
+
+				this->sendMessageHeaders[i] = mmsghdr{};
+				this->sendMessageHeaders[i].msg_hdr.msg_name = &message.address;
+				this->sendMessageHeaders[i].msg_hdr.msg_namelen = kt::getAddressLength(message.address);
+				this->sendMessageHeaders[i].msg_hdr.msg_iov = &this->sendVectors[i];
+				this->sendMessageHeaders[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			int result = sendmmsg(sendSocket, this->sendMessageHeaders.data(), static_cast<unsigned int>(batchSize), flags);
+			if (result < 1)
+			{
+				// The first message in the batch failed, skip it and carry on with the rest
+				messages[sent].result = -1;
+				sent++;
+				continue;
+			}
+
+			for (int i = 0; i < result; i++)
+			{
+				messages[sent + i].result = static_cast<int>(this->sendMessageHeaders[i].msg_len);
+			}
+			sent += result;
+			sentMessages += result;
+		}
+#else
+		for (size_t i = 0; i < messageCount; i++)
+		{
+			messages[i].result = ::sendto(sendSocket, messages[i].buffer, messages[i].length, flags, &(messages[i].address.address), kt::getAddressLength(messages[i].address));
+			if (messages[i].result >= 0)
+			{
+				sentMessages++;
+			}
+		}
+#endif
+		return sentMessages;
+	}
+
 	std::pair<std::optional<std::string>, std::pair<int, kt::SocketAddress>> UDPSocket::receiveFrom(const int& receiveLength, const int& flags)
 	{
 		std::string data;
@@ -211,6 +390,104 @@ namespace kt
 		return std::make_pair(flag, receiveAddress);
 	}
 
+	int UDPSocket::receiveBatch(std::vector<kt::UDPReceiveSlot>& slots, const long& timeout, const int& flags)
+	{
+		return this->receiveBatch(slots.data(), slots.size(), timeout, flags);
+	}
+
+	/**
+	 * Receives as many queued datagrams as there are slots, one datagram per slot. On Linux this is a single recvmmsg() call,
+	 * other platforms fall back to one recvfrom() per datagram.
+	 * The call waits for the first datagram and then only collects datagrams that have already arrived.
+	 *
+	 * @param slots - The caller owned slots to fill. Only the first *n* slots are modified, where *n* is the returned value.
+	 * @param slotCount - The amount of slots pointed to by *slots*.
+	 * @param timeout - The amount of microseconds to wait for the first datagram, 0 waits until one arrives.
+	 *
+	 * @return the amount of slots filled, 0 if the timeout elapsed, or -1 if this socket is not bound or the receive failed.
+	 */
+	int UDPSocket::receiveBatch(kt::UDPReceiveSlot* slots, const size_t& slotCount, const long& timeout, const int& flags)
+	{
+		if (!isBound())
+		{
+			return -1;
+		}
+		if (slotCount == 0)
+		{
+			return 0;
+		}
+
+		if (timeout > 0)
+		{
+			int result = Socket::pollSocket(this->receiveSocket, timeout);
+			if (result < 1)
+			{
+				return result;
+			}
+		}
+
+#ifdef __linux__
+		// The kernel will not accept more than UIO_MAXIOV messages in a single call
+		const size_t batchSize = std::min(slotCount, static_cast<size_t>(1024));
+		if (this->receiveMessageHeaders.size() < batchSize)
+		{
+			this->receiveMessageHeaders.resize(batchSize);
+			this->receiveVectors.resize(batchSize);
+		}
+
+		for (size_t i = 0; i < batchSize; i++)
+		{
+			this->receiveVectors[i].iov_base = slots[i].buffer;
+			this->receiveVectors[i].iov_len = slots[i].capacity;
+
+			this->receiveMessageHeaders[i] = mmsghdr{};
+			this->receiveMessageHeaders[i].msg_hdr.msg_name = &slots[i].address;
+			this->receiveMessageHeaders[i].msg_hdr.msg_namelen = sizeof(slots[i].address);
+			this->receiveMessageHeaders[i].msg_hdr.msg_iov = &this->receiveVectors[i];
+			this->receiveMessageHeaders[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int received = recvmmsg(this->receiveSocket, this->receiveMessageHeaders.data(), static_cast<unsigned int>(batchSize), flags | MSG_WAITFORONE, nullptr);
+		for (int i = 0; i < received; i++)
+		{
+			slots[i].length = static_cast<int>(this->receiveMessageHeaders[i].msg_len);
+			slots[i].truncated = (this->receiveMessageHeaders[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+		}
+		return received;
+#else
+		int received = 0;
+		for (size_t i = 0; i < slotCount; i++)
+		{
+			// Only wait on the first datagram, the rest must already be queued
+			if (i > 0 && Socket::pollSocket(this->receiveSocket, 0) < 1)
+			{
+				break;
+			}
+
+			// Matching receiveFrom(), a zeroed address resolves to the largest address length
+			slots[i].address = kt::SocketAddress{};
+			auto addressLength = kt::getAddressLength(slots[i].address);
+			int result = ::recvfrom(this->receiveSocket, slots[i].buffer, slots[i].capacity, flags, &slots[i].address.address, &addressLength);
+#ifdef _WIN32
+			slots[i].truncated = result == -1 && WSAGetLastError() == WSAEMSGSIZE;
+			if (slots[i].truncated)
+			{
+				result = slots[i].capacity;
+			}
+#else
+			slots[i].truncated = false;
+#endif
+			if (result < 0)
+			{
+				return received == 0 ? -1 : received;
+			}
+			slots[i].length = result;
+			received++;
+		}
+		return received;
+#endif
+	}
+
     SOCKET UDPSocket::getListeningSocket() const
     {
         return this->receiveSocket;
@@ -234,11 +511,152 @@ namespace kt
 		return this->listeningPort;
 	}
 
+    /**
+	 * Sets an operation that is run against each newly created send socket before it is first used.
+	 * Any cached send sockets are closed so that the new operation is applied to the sockets used by the next send.
+	 */
     void UDPSocket::setPreSendSocketOperation(std::function<void(SOCKET&)> newOperation)
     {
 		this->preSendSocketOperation = std::make_optional(newOperation);
+		this->closeSendSockets();
     }
 
+	/**
+	 * When enabled, *sendTo()* keeps one send socket per address family open for the life of this *kt::UDPSocket* instead of
+	 * creating and closing a socket for every message. The cached sockets are closed by *close()* or when caching is disabled.
+	 */
+	void UDPSocket::setSendSocketCaching(const bool& enabled)
+	{
+		this->cacheSendSockets = enabled;
+		if (!enabled)
+		{
+			this->closeSendSockets();
+		}
+	}
+
+	bool UDPSocket::isSendSocketCachingEnabled() const
+	{
+		return this->cacheSendSockets;
+	}
+
+	/**
+	 * Creates a socket that is connected to the provided address, which is then used by *send()*.
+	 * This allows repeated sends to a fixed peer to skip the address handling performed by *sendTo()*.
+	 * Any previously connected address is disconnected first.
+	 *
+	 * @return the result of the call to connect(), -1 if the connection failed or -2 if a socket could not be created.
+	 */
+	int UDPSocket::connect(const kt::SocketAddress& address)
+	{
+		this->disconnect();
+
+		SOCKET newSocket = this->createSendSocket(address.address.sa_family);
+		if (kt::isInvalidSocket(newSocket))
+		{
+			return -2;
+		}
+
+		int result = ::connect(newSocket, &(address.address), kt::getAddressLength(address));
+		if (result != 0)
+		{
+			Socket::close(newSocket);
+			return result;
+		}
+
+		this->connectedSocket = newSocket;
+		this->connectedAddress = address;
+		this->connectionGeneration++;
+		return result;
+	}
+
+	bool UDPSocket::isConnected() const
+	{
+		return !kt::isInvalidSocket(this->connectedSocket);
+	}
+
+	std::optional<kt::SocketAddress> UDPSocket::getConnectedAddress() const
+	{
+		return this->connectedAddress;
+	}
+
+	/**
+	 * @return the socket used by *send()* while connected, otherwise an invalid socket.
+	 */
+	SOCKET UDPSocket::getConnectedSocket() const
+	{
+		return this->connectedSocket;
+	}
+
+	/**
+	 * @return a counter that is increased by every successful *connect()*, so a caller holding on to the connected socket can tell
+	 * that it has since been replaced, even when the new descriptor reuses the old number.
+	 */
+	unsigned int UDPSocket::getConnectionGeneration() const
+	{
+		return this->connectionGeneration;
+	}
+
+	int UDPSocket::send(const std::string& message, const int& flags)
+	{
+		return this->send(message.c_str(), message.size(), flags);
+	}
+
+	/**
+	 * Sends the provided buffer to the address provided to *connect()*.
+	 *
+	 * @return the result of the call to send(), or -1 if this socket is not connected.
+	 */
+	int UDPSocket::send(const char* buffer, const int& bufferLength, const int& flags)
+	{
+		if (!this->isConnected())
+		{
+			return -1;
+		}
+		return ::send(this->connectedSocket, buffer, bufferLength, flags);
+	}
+
+	void UDPSocket::disconnect()
+	{
+		if (this->isConnected())
+		{
+			Socket::close(this->connectedSocket);
+		}
+		this->connectedSocket = kt::getInvalidSocketValue();
+		this->connectedAddress = std::nullopt;
+	}
+
+	SOCKET UDPSocket::createSendSocket(const int& addressFamily) const
+	{
+		SOCKET newSocket = socket(addressFamily, SOCK_DGRAM, IPPROTO_UDP);
+		if (!kt::isInvalidSocket(newSocket) && this->preSendSocketOperation.has_value())
+		{
+			this->preSendSocketOperation.value()(newSocket);
+		}
+		return newSocket;
+	}
+
+	SOCKET UDPSocket::getSendSocket(const int& addressFamily)
+	{
+		SOCKET& cachedSocket = addressFamily == AF_INET6 ? this->sendSocketIPV6 : this->sendSocketIPV4;
+		if (kt::isInvalidSocket(cachedSocket))
+		{
+			cachedSocket = this->createSendSocket(addressFamily);
+		}
+		return cachedSocket;
+	}
+
+	void UDPSocket::closeSendSockets()
+	{
+		for (SOCKET* cachedSocket : { &this->sendSocketIPV4, &this->sendSocketIPV6 })
+		{
+			if (!kt::isInvalidSocket(*cachedSocket))
+			{
+				Socket::close(*cachedSocket);
+				*cachedSocket = kt::getInvalidSocketValue();
+			}
+		}
+	}
+
     int UDPSocket::pollSocket(SOCKET socket, const long& timeout) const
 	{
 		if (kt::isInvalidSocket(socket))
@@ -9,6 +9,7 @@
 #include "../enums/InternetProtocolVersion.h"
 #include "../address/SocketAddress.h"
 #include "../socketexceptions/SocketError.h"
+#include "../socketexceptions/Result.h"
 #include "ConnectionLessSocket.h"
 
 #include "Socket.h"
@@ -40,6 +41,32 @@ typedef int SOCKET;
 
 namespace kt
 {
+	/**
+	 * A single datagram to be sent by *kt::UDPSocket::sendBatch()*.
+	 * After the call *result* holds the amount of bytes sent for this message, or -1 if it could not be sent.
+	 */
+	struct UDPSendMessage
+	{
+		kt::SocketAddress address{};
+		const char* buffer = nullptr;
+		int length = 0;
+		int result = 0;
+	};
+
+	/**
+	 * A caller owned buffer that is filled by *kt::UDPSocket::receiveBatch()* with a single datagram.
+	 * *length* is set to the amount of bytes written into *buffer*, *address* to the sender and *truncated* is *true* when the
+	 * datagram was larger than *capacity* and the remainder was discarded.
+	 */
+	struct UDPReceiveSlot
+	{
+		char* buffer = nullptr;
+		int capacity = 0;
+		int length = 0;
+		kt::SocketAddress address{};
+		bool truncated = false;
+	};
+
 	class UDPSocket : public ConnectionLessSocket<kt::SocketAddress>
 	{
 	protected:
@@ -49,8 +76,27 @@ namespace kt
 		std::optional<unsigned short> listeningPort = std::nullopt;
 		std::optional<std::function<void(SOCKET&)>> preSendSocketOperation = std::nullopt;
 
+		bool cacheSendSockets = false;
+		SOCKET sendSocketIPV4 = getInvalidSocketValue();
+		SOCKET sendSocketIPV6 = getInvalidSocketValue();
+		SOCKET connectedSocket = getInvalidSocketValue();
+		std::optional<kt::SocketAddress> connectedAddress = std::nullopt;
+		unsigned int connectionGeneration = 0;
+
+#ifdef __linux__
+		// Reused between calls to sendBatch() so that batches do not allocate once they reach their largest size
+		std::vector<mmsghdr> sendMessageHeaders;
+		std::vector<iovec> sendVectors;
+		std::vector<mmsghdr> receiveMessageHeaders;
+		std::vector<iovec> receiveVectors;
+#endif
+
 		int pollSocket(SOCKET socket, const long& = 1000) const;
 		void initialiseListeningPortNumber();
+		SOCKET createSendSocket(const int&) const;
+		SOCKET getSendSocket(const int&);
+		void closeSendSockets();
+		int sendBatchToSocket(const SOCKET&, kt::UDPSendMessage*, const size_t&, const int&);
 
 	public:
 		UDPSocket() = default;
@@ -64,6 +110,7 @@ namespace kt
 		using ConnectionLessSocket::bind;
 		std::pair<int, kt::SocketAddress> bind(const kt::InternetProtocolVersion, const std::optional<std::string>& = std::nullopt, const unsigned short& = 0, const std::optional<std::function<void(SOCKET&)>>& = std::nullopt);
 		std::pair<int, kt::SocketAddress> bind(const std::optional<kt::SocketAddress>& = std::nullopt, const std::optional<std::function<void(SOCKET&)>>& = std::nullopt) override;
+		kt::Result<kt::SocketAddress> tryBind(const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any, const std::optional<std::string>& = std::nullopt, const unsigned short& = 0) noexcept;
 		bool isBound() const override;
 		
 		bool ready(const unsigned long = 100) const override;
@@ -73,12 +120,27 @@ namespace kt
 		int sendTo(const kt::SocketAddress&, const char*, const int&, const int& = 0) override;
 		std::pair<int, kt::SocketAddress> sendTo(const std::string&, const unsigned short&, const std::string&, const int& = 0, const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any);
 		std::pair<int, kt::SocketAddress> sendTo(const std::string&, const unsigned short&, const char*, const int&, const int& = 0, const kt::InternetProtocolVersion = kt::InternetProtocolVersion::Any);
+		int sendBatch(kt::UDPSendMessage*, const size_t&, const int& = 0);
+		int sendBatch(std::vector<kt::UDPSendMessage>&, const int& = 0);
 		
 		using ConnectionLessSocket::receiveFrom;
 		std::pair<std::optional<std::string>, std::pair<int, kt::SocketAddress>> receiveFrom(const int&, const int& = 0) override;
 		std::pair<int, kt::SocketAddress> receiveFrom(char*, const int&, const int& = 0) const override;
+		int receiveBatch(kt::UDPReceiveSlot*, const size_t&, const long& = 0, const int& = 0);
+		int receiveBatch(std::vector<kt::UDPReceiveSlot>&, const long& = 0, const int& = 0);
 
 		void setPreSendSocketOperation(std::function<void(SOCKET&)>);
+		void setSendSocketCaching(const bool&);
+		bool isSendSocketCachingEnabled() const;
+
+		int connect(const kt::SocketAddress&);
+		bool isConnected() const;
+		std::optional<kt::SocketAddress> getConnectedAddress() const;
+		SOCKET getConnectedSocket() const;
+		unsigned int getConnectionGeneration() const;
+		int send(const std::string&, const int& = 0);
+		int send(const char*, const int&, const int& = 0);
+		void disconnect();
 
 		void close() override;
 	};
@@ -0,0 +1,260 @@
+#include "ZeroCopySender.h"
+#include "../socketexceptions/SocketError.h"
+
+#include <cerrno>
+#include <limits>
+#include <vector>
+
+#ifdef __linux__
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+
+#endif
+
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    #define KT_ZEROCOPY_SUPPORTED
+#endif
+
+namespace kt
+{
+    /**
+     * ZeroCopySender constructor for a connected *kt::TCPSocket*.
+     *
+     * @param socket - The connected socket to send on.
+     * @param threshold - Sends of fewer bytes than this are copied instead.
+     */
+    ZeroCopySender::ZeroCopySender(const kt::TCPSocket& socket, const size_t& threshold) : tcpSocket(&socket), threshold(threshold)
+    {
+        this->enabled = this->enableZeroCopy();
+    }
+
+    /**
+     * ZeroCopySender constructor for a *kt::UDPSocket*, which must already be connected with *kt::UDPSocket::connect()*.
+     *
+     * @param socket - The connected socket to send on.
+     * @param threshold - Sends of fewer bytes than this are copied instead.
+     */
+    ZeroCopySender::ZeroCopySender(kt::UDPSocket& socket, const size_t& threshold) : udpSocket(&socket), threshold(threshold)
+    {
+        this->enabled = this->enableZeroCopy();
+    }
+
+    SOCKET ZeroCopySender::getSocket() const
+    {
+        return this->tcpSocket != nullptr ? this->tcpSocket->getSocket() : this->udpSocket->getConnectedSocket();
+    }
+
+    int ZeroCopySender::sendToSocket(const char* buffer, const int& length, const int& flags)
+    {
+        return this->tcpSocket != nullptr ? this->tcpSocket->send(buffer, length, flags) : this->udpSocket->send(buffer, length, flags);
+    }
+
+    bool ZeroCopySender::enableZeroCopy()
+    {
+#ifdef KT_ZEROCOPY_SUPPORTED
+        const SOCKET socket = this->getSocket();
+        const int enable = 1;
+        if (kt::isInvalidSocket(socket) || setsockopt(socket, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) != 0)
+        {
+            return false;
+        }
+        this->zeroCopySocket = socket;
+        if (this->udpSocket != nullptr)
+        {
+            this->zeroCopyGeneration = this->udpSocket->getConnectionGeneration();
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Checks the socket is still the descriptor zero-copy was enabled on. A *kt::UDPSocket* that was reconnected has a new
+     * descriptor, which may reuse the old number, so its connection generation is compared as well. A send on the new descriptor
+     * would not be given an id by the kernel, leaving every later callback matched to the wrong send.
+     */
+    bool ZeroCopySender::canSendZeroCopy() const
+    {
+        if (!this->enabled || this->getSocket() != this->zeroCopySocket)
+        {
+            return false;
+        }
+        return this->udpSocket == nullptr || this->udpSocket->getConnectionGeneration() == this->zeroCopyGeneration;
+    }
+
+    /**
+     * Sends the buffer, without copying it when it is at least the threshold in size and zero-copy is enabled.
+     *
+     * @param buffer - The data to send, which must not be modified or freed until *onReusable* is called.
+     * @param length - The amount of bytes to send.
+     * @param onReusable - Called once the kernel no longer references the buffer. For copied sends this happens before *send()*
+     * returns, otherwise from within *processCompletions()*. It is not called if the send fails.
+     * @param flags - Additional flags passed to the underlying send call.
+     *
+     * @return the amount of bytes sent, or -1 on error. As with *send()* on a stream socket fewer bytes than requested may be sent,
+     * in which case *onReusable* covers only the bytes that were sent.
+     */
+    int ZeroCopySender::send(const char* buffer, const int& length, const std::function<void()>& onReusable, const int& flags)
+    {
+#ifdef KT_ZEROCOPY_SUPPORTED
+        // The kernel does not assign an id to an empty send
+        if (length > 0 && static_cast<size_t>(length) >= this->threshold && this->canSendZeroCopy())
+        {
+            const int sent = this->sendToSocket(buffer, length, flags | MSG_ZEROCOPY);
+            if (sent >= 0)
+            {
+                this->pending.emplace(this->nextId++, onReusable);
+                return sent;
+            }
+
+            // ENOBUFS means the socket is over its pinned memory limit, which copying avoids
+            if (errno != ENOBUFS)
+            {
+                return sent;
+            }
+        }
+#endif
+
+        const int sent = this->sendToSocket(buffer, length, flags);
+        if (sent >= 0 && onReusable)
+        {
+            onReusable();
+        }
+        return sent;
+    }
+
+    /**
+     * Runs and removes the callbacks of the sends with ids from *low* to *high* inclusive, which may wrap around.
+     */
+    size_t ZeroCopySender::complete(const uint32_t& low, const uint32_t& high)
+    {
+        std::vector<std::function<void()>> completed;
+        auto take = [this, &completed](const uint32_t& from, const uint32_t& to)
+        {
+            auto end = this->pending.upper_bound(to);
+            for (auto it = this->pending.lower_bound(from); it != end; it = this->pending.erase(it))
+            {
+                completed.push_back(std::move(it->second));
+            }
+        };
+
+        if (low <= high)
+        {
+            take(low, high);
+        }
+        else
+        {
+            take(low, std::numeric_limits<uint32_t>::max());
+            take(0, high);
+        }
+
+        // Run after the map is updated so a callback can safely send again
+        for (const std::function<void()>& callback : completed)
+        {
+            if (callback)
+            {
+                callback();
+            }
+        }
+        return completed.size();
+    }
+
+    /**
+     * Reads the completion notifications the kernel has queued on the socket's error queue and runs the callback of every send it
+     * has finished with.
+     *
+     * @param timeout - The amount of microseconds to wait for a notification when none has arrived yet, 0 only collects the
+     * notifications that have already arrived.
+     *
+     * @return the amount of sends completed by this call.
+     */
+    size_t ZeroCopySender::processCompletions(const long& timeout)
+    {
+        size_t completed = 0;
+#ifdef KT_ZEROCOPY_SUPPORTED
+        const SOCKET socket = this->getSocket();
+        if (this->pending.empty() || kt::isInvalidSocket(socket) || !this->canSendZeroCopy())
+        {
+            return completed;
+        }
+
+        if (timeout > 0)
+        {
+            // The error queue is reported as POLLERR whichever events are requested
+            pollfd descriptor{};
+            descriptor.fd = socket;
+            descriptor.events = 0;
+            ::poll(&descriptor, 1, static_cast<int>((timeout + 999) / 1000));
+        }
+
+        while (!this->pending.empty())
+        {
+            char control[128];
+            msghdr message{};
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+            if (::recvmsg(socket, &message, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+            {
+                break;
+            }
+
+            for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+            {
+                if (!((header->cmsg_level == SOL_IP && header->cmsg_type == IP_RECVERR) || (header->cmsg_level == SOL_IPV6 && header->cmsg_type == IPV6_RECVERR)))
+                {
+                    continue;
+                }
+
+                const sock_extended_err* error = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(header));
+                if (error->ee_errno != 0 || error->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                {
+                    continue;
+                }
+
+                // The kernel reports a range of consecutive send ids per notification
+                if ((error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0)
+                {
+                    this->copiedCount += static_cast<size_t>(error->ee_data - error->ee_info) + 1;
+                }
+                completed += this->complete(error->ee_info, error->ee_data);
+            }
+        }
+#else
+        (void)timeout;
+#endif
+        return completed;
+    }
+
+    /**
+     * @return *true* if the kernel accepted *SO_ZEROCOPY* for the socket, otherwise every send is copied.
+     */
+    bool ZeroCopySender::isZeroCopyEnabled() const
+    {
+        return this->enabled;
+    }
+
+    size_t ZeroCopySender::getThreshold() const
+    {
+        return this->threshold;
+    }
+
+    /**
+     * @return the amount of zero-copy sends whose buffers are still referenced by the kernel.
+     */
+    size_t ZeroCopySender::getPendingCount() const
+    {
+        return this->pending.size();
+    }
+
+    /**
+     * @return the amount of zero-copy sends the kernel ended up copying anyway, for example because the data was sent over loopback
+     * or the device does not support scatter-gather. If most sends are copied the threshold should be raised.
+     */
+    size_t ZeroCopySender::getCopiedCount() const
+    {
+        return this->copiedCount;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "TCPSocket.h"
+#include "UDPSocket.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+
+namespace kt
+{
+    /**
+     * Sends large buffers from a *kt::TCPSocket* or connected *kt::UDPSocket* without copying them into the kernel, using
+     * *MSG_ZEROCOPY* on Linux. The kernel reads straight from the caller's buffer after *send()* returns, so the buffer must stay
+     * untouched until its *onReusable* callback is run by *processCompletions()*.
+     *
+     * Sends smaller than the threshold, and all sends where zero-copy is unavailable (other platforms, kernels without
+     * *SO_ZEROCOPY*, or socket types that do not support it such as unix domain sockets), are copied as usual and their callback is
+     * run before *send()* returns. The same applies once a *kt::UDPSocket* is reconnected, since the new descriptor was never
+     * enabled for zero-copy; create a new sender after reconnecting.
+     *
+     * The socket is held by reference and must outlive the sender. A sender is not thread safe.
+     */
+    class ZeroCopySender
+    {
+        private:
+            const kt::TCPSocket* tcpSocket = nullptr;
+            kt::UDPSocket* udpSocket = nullptr;
+            size_t threshold;
+            bool enabled = false;
+            // The descriptor SO_ZEROCOPY was enabled on, the kernel's send ids are only meaningful for this descriptor
+            SOCKET zeroCopySocket = getInvalidSocketValue();
+            // The kt::UDPSocket connection generation zeroCopySocket belongs to, unused for a kt::TCPSocket
+            unsigned int zeroCopyGeneration = 0;
+
+            // Keyed by the id the kernel assigns to each zero-copy send, in the order they were made
+            std::map<uint32_t, std::function<void()>> pending;
+            uint32_t nextId = 0;
+            size_t copiedCount = 0;
+
+            SOCKET getSocket() const;
+            int sendToSocket(const char*, const int&, const int&);
+            bool enableZeroCopy();
+            bool canSendZeroCopy() const;
+            size_t complete(const uint32_t&, const uint32_t&);
+
+        public:
+            // Below roughly this size the cost of pinning pages and reading the completion outweighs the copy it saves
+            static constexpr size_t DEFAULT_THRESHOLD = 16 * 1024;
+
+            ZeroCopySender(const kt::TCPSocket&, const size_t& = DEFAULT_THRESHOLD);
+            ZeroCopySender(kt::UDPSocket&, const size_t& = DEFAULT_THRESHOLD);
+
+            int send(const char*, const int&, const std::function<void()>& = nullptr, const int& = 0);
+            size_t processCompletions(const long& = 0);
+
+            bool isZeroCopyEnabled() const;
+            size_t getThreshold() const;
+            size_t getPendingCount() const;
+            size_t getCopiedCount() const;
+    };
+}
@@ -0,0 +1,46 @@
+#include "Result.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <WinSock2.h>
+#include <ws2tcpip.h>
+
+#else
+
+#include <netdb.h>
+
+#endif
+
+namespace kt
+{
+    /**
+     * Formats the text for a *kt::Result* error. Only called when the text is actually wanted.
+     */
+    std::string getResultErrorMessage(const kt::ResultError& error, const int& code)
+    {
+        switch (error)
+        {
+            case kt::ResultError::None:
+                return "";
+            case kt::ResultError::Timeout:
+                return "The operation timed out.";
+            case kt::ResultError::WouldBlock:
+                return "The operation would block.";
+            case kt::ResultError::Closed:
+                return "The connection was closed.";
+            case kt::ResultError::InvalidSocket:
+                return "The socket is not valid.";
+            case kt::ResultError::Resolve:
+                return "Unable to resolve address: " + std::string(gai_strerror(code)) + " (" + std::to_string(code) + ")";
+            case kt::ResultError::System:
+                return std::string(std::strerror(code)) + " (" + std::to_string(code) + ")";
+        }
+        return "Unknown error (" + std::to_string(code) + ")";
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace kt
+{
+    /**
+     * Why a *kt::Result* holds no value.
+     */
+    enum class ResultError : uint8_t
+    {
+        None,
+        // The operation did not complete within the requested timeout
+        Timeout,
+        // A non-blocking operation could not proceed without waiting
+        WouldBlock,
+        // The remote closed or reset the connection
+        Closed,
+        // The socket has been closed or was never created
+        InvalidSocket,
+        // The hostname could not be resolved, the code is the *getaddrinfo()* result
+        Resolve,
+        // A system call failed, the code is the *errno* (or *WSAGetLastError()*) value
+        System
+    };
+
+    std::string getResultErrorMessage(const kt::ResultError&, const int&);
+
+    /**
+     * The outcome of one of the exception-free *try* methods: either a value, or the reason there is none along with the error code
+     * captured at the time. No text is built unless *getErrorMessage()* is called, so failures that are expected, such as timeouts in
+     * a polling loop, cost no more than the successful path.
+     */
+    template <typename T>
+    class Result
+    {
+        private:
+            std::optional<T> result;
+            kt::ResultError error = kt::ResultError::None;
+            int code = 0;
+
+        public:
+            Result(const T& value) : result(value) {}
+            Result(T&& value) noexcept : result(std::move(value)) {}
+            Result(const kt::ResultError& error, const int& code = 0) noexcept : error(error), code(code) {}
+
+            bool isSuccess() const noexcept
+            {
+                return this->result.has_value();
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return this->isSuccess();
+            }
+
+            /**
+             * @throw std::bad_optional_access - If the result holds no value.
+             */
+            T& value()
+            {
+                return this->result.value();
+            }
+
+            /**
+             * @throw std::bad_optional_access - If the result holds no value.
+             */
+            const T& value() const
+            {
+                return this->result.value();
+            }
+
+            kt::ResultError getError() const noexcept
+            {
+                return this->error;
+            }
+
+            /**
+             * @return the system or resolver error code for *System* and *Resolve* errors, otherwise 0.
+             */
+            int getCode() const noexcept
+            {
+                return this->code;
+            }
+
+            std::string getErrorMessage() const
+            {
+                return kt::getResultErrorMessage(this->error, this->code);
+            }
+    };
+}
@@ -27,6 +27,20 @@ namespace kt
 		return toReturn;
 	}
 
+	/**
+	 * @return the error code of the last failed socket call, *WSAGetLastError()* on Windows and *errno* otherwise.
+	 */
+	int getLastError()
+	{
+#ifdef _WIN32
+		return WSAGetLastError();
+
+#else
+		return errno;
+
+#endif
+	}
+
 	SOCKET getInvalidSocketValue()
 	{
 #ifdef _WIN32
@@ -43,5 +57,48 @@ namespace kt
 		return descriptor == getInvalidSocketValue();
 	}
 
+	/**
+	 * @return *true* if the last socket call failed because a non-blocking socket could not proceed without waiting.
+	 */
+	bool isWouldBlockError()
+	{
+#ifdef _WIN32
+		return WSAGetLastError() == WSAEWOULDBLOCK;
+
+#else
+		return errno == EAGAIN || errno == EWOULDBLOCK;
+
+#endif
+	}
+
+	/**
+	 * @return *true* if the last socket call failed because the remote closed or reset the connection.
+	 */
+	bool isConnectionClosedError()
+	{
+#ifdef _WIN32
+		const int error = WSAGetLastError();
+		return error == WSAECONNRESET || error == WSAECONNABORTED || error == WSAESHUTDOWN;
+
+#else
+		return errno == EPIPE || errno == ECONNRESET;
+
+#endif
+	}
+
+	/**
+	 * @return *true* if the last call to *connect()* on a non-blocking socket has started but not yet completed the connection.
+	 */
+	bool isConnectInProgressError()
+	{
+#ifdef _WIN32
+		return WSAGetLastError() == WSAEWOULDBLOCK;
+
+#else
+		return errno == EINPROGRESS;
+
+#endif
+	}
+
 } // End kt namespace
 
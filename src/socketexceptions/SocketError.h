@@ -24,7 +24,15 @@ namespace kt
 {
 	std::string getErrorCode();
 
+	int getLastError();
+
 	SOCKET getInvalidSocketValue();
 
 	bool isInvalidSocket(SOCKET descriptor);
+
+	bool isWouldBlockError();
+
+	bool isConnectionClosedError();
+
+	bool isConnectInProgressError();
 } // End kt namespace
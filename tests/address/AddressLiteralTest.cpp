@@ -0,0 +1,82 @@
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/address/AddressLiteral.h"
+#include "../../src/address/SocketAddress.h"
+
+namespace kt
+{
+    static_assert(parseIPv4Literal("10.0.3.7").value()[3] == 7, "IPv4 literals are parsed at compile time");
+    static_assert(parseIPv6Literal("::1").value()[15] == 1, "IPv6 literals are parsed at compile time");
+    static_assert(!parseIPv4Literal("localhost").has_value(), "Hostnames are not literals");
+
+    /*
+     * Ensure the IPv4 parser accepts and rejects exactly what inet_pton() does.
+     */
+    TEST(AddressLiteralTest, TestIPv4MatchesInetPton)
+    {
+        const std::vector<std::string> inputs = { "10.0.3.7", "0.0.0.0", "255.255.255.255", "127.0.0.1", "256.0.0.1", "1.2.3", "1.2.3.4.5",
+            "01.2.3.4", "1..2.3", ".1.2.3", "1.2.3.", "1.2.3.4 ", "a.b.c.d", "", "localhost" };
+        for (const std::string& input : inputs)
+        {
+            in_addr expected{};
+            const bool valid = inet_pton(AF_INET, input.c_str(), &expected) == 1;
+            std::optional<std::array<uint8_t, 4>> parsed = parseIPv4Literal(input);
+            ASSERT_EQ(valid, parsed.has_value()) << input;
+            if (valid)
+            {
+                ASSERT_EQ(0, std::memcmp(&expected, parsed.value().data(), parsed.value().size())) << input;
+            }
+        }
+    }
+
+    /*
+     * Ensure the IPv6 parser accepts and rejects exactly what inet_pton() does.
+     */
+    TEST(AddressLiteralTest, TestIPv6MatchesInetPton)
+    {
+        const std::vector<std::string> inputs = { "::", "::1", "1::", "2001:db8::7", "2001:DB8:0:0:8:800:200C:417A", "fe80::1:2", "::ffff:10.0.3.7",
+            "1:2:3:4:5:6:7:8", "1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:7::", "::2:3:4:5:6:7:8", "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7", ":::",
+            "1:::2", "1::2::3", ":1::2", "1::2:", "12345::", "::ffff:1.2.3", "1:2:3:4:5:6:7:1.2.3.4", "fe80::1%eth0", "", ":", "10.0.3.7" };
+        for (const std::string& input : inputs)
+        {
+            in6_addr expected{};
+            const bool valid = inet_pton(AF_INET6, input.c_str(), &expected) == 1;
+            std::optional<std::array<uint8_t, 16>> parsed = parseIPv6Literal(input);
+            ASSERT_EQ(valid, parsed.has_value()) << input;
+            if (valid)
+            {
+                ASSERT_EQ(0, std::memcmp(&expected, parsed.value().data(), parsed.value().size())) << input;
+            }
+        }
+    }
+
+    /*
+     * Ensure literals resolve to the same address getaddrinfo() returns, and that the requested version is respected.
+     */
+    TEST(AddressLiteralTest, TestResolveLiteral)
+    {
+        addrinfo hints = createTcpHints();
+        std::pair<std::vector<SocketAddress>, int> fast = resolveToAddresses("127.0.0.1", 8080, hints);
+        std::pair<std::vector<SocketAddress>, int> resolved = resolveToAddressesUncached("127.0.0.1", 8080, hints);
+        ASSERT_EQ(0, fast.second);
+        ASSERT_EQ(1, fast.first.size());
+        ASSERT_EQ(0, std::memcmp(&resolved.first.front().ipv4, &fast.first.front().ipv4, sizeof(sockaddr_in)));
+
+        hints = createUdpHints(InternetProtocolVersion::IPV6);
+        fast = resolveToAddresses("::1", 8080, hints);
+        resolved = resolveToAddressesUncached("::1", 8080, hints);
+        ASSERT_EQ(0, fast.second);
+        ASSERT_EQ(1, fast.first.size());
+        ASSERT_EQ(0, std::memcmp(&resolved.first.front().ipv6, &fast.first.front().ipv6, sizeof(sockaddr_in6)));
+
+        ASSERT_FALSE(parseAddressLiteral("::1", 80, InternetProtocolVersion::IPV4).has_value());
+        ASSERT_FALSE(parseAddressLiteral("127.0.0.1", 80, InternetProtocolVersion::IPV6).has_value());
+        ASSERT_EQ(InternetProtocolVersion::IPV4, getInternetProtocolVersion(parseAddressLiteral("127.0.0.1", 80).value()));
+        ASSERT_EQ(80, getPortNumber(parseAddressLiteral("::1", 80).value()));
+    }
+}
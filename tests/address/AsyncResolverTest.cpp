@@ -0,0 +1,101 @@
+#include <future>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/address/AsyncResolver.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/socket/UDPSocket.h"
+
+namespace kt
+{
+    const std::string RESOLVER_HOSTNAME = "localhost";
+
+    /*
+     * Ensure a resolved address can be used to connect without resolving again.
+     */
+    TEST(AsyncResolverTest, TestResolveFuture)
+    {
+        TCPServerSocket serverSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4);
+        AsyncResolver resolver;
+
+        std::shared_future<std::pair<std::vector<SocketAddress>, int>> future = resolver.resolve(RESOLVER_HOSTNAME, serverSocket.getPort(), createTcpHints(InternetProtocolVersion::IPV4));
+        const std::pair<std::vector<SocketAddress>, int>& resolved = future.get();
+        ASSERT_EQ(0, resolved.second);
+        ASSERT_FALSE(resolved.first.empty());
+
+        TCPSocket socket(resolved.first.front());
+        TCPSocket server = serverSocket.accept(1000000);
+        const std::string testString = "resolved";
+        ASSERT_EQ(testString.size(), socket.send(testString));
+        ASSERT_EQ(testString, server.receiveAmount(testString.size()));
+
+        socket.close();
+        server.close();
+        serverSocket.close();
+    }
+
+    /*
+     * Ensure the callback is given the result, which can be sent to directly.
+     */
+    TEST(AsyncResolverTest, TestResolveCallback)
+    {
+        UDPSocket udpSocket;
+        ASSERT_EQ(0, udpSocket.bind(InternetProtocolVersion::IPV4).first);
+        AsyncResolver resolver(1);
+
+        std::promise<std::pair<std::vector<SocketAddress>, int>> result;
+        resolver.resolve(RESOLVER_HOSTNAME, udpSocket.getListeningPort().value(), createUdpHints(InternetProtocolVersion::IPV4), [&result](const std::pair<std::vector<SocketAddress>, int>& resolved)
+        {
+            result.set_value(resolved);
+        });
+        std::pair<std::vector<SocketAddress>, int> resolved = result.get_future().get();
+        ASSERT_EQ(0, resolved.second);
+
+        UDPSocket client;
+        const std::string testString = "datagram";
+        ASSERT_EQ(testString.size(), client.sendTo(resolved.first.front(), testString));
+        ASSERT_EQ(testString, udpSocket.receiveFrom(testString.size()).first.value());
+
+        udpSocket.close();
+    }
+
+    /*
+     * Ensure requests for a lookup that is already pending share it.
+     */
+    TEST(AsyncResolverTest, TestCoalescing)
+    {
+        AsyncResolver resolver(1);
+        const addrinfo hints = createTcpHints(InternetProtocolVersion::IPV4);
+
+        // Hold the only resolver thread in a callback so the next requests stay pending
+        std::promise<void> blocked;
+        std::promise<void> unblock;
+        std::shared_future<void> unblocked = unblock.get_future().share();
+        resolver.resolve(RESOLVER_HOSTNAME, 1, hints, [&blocked, unblocked](const std::pair<std::vector<SocketAddress>, int>&)
+        {
+            blocked.set_value();
+            unblocked.wait();
+        });
+        blocked.get_future().wait();
+
+        std::vector<std::shared_future<std::pair<std::vector<SocketAddress>, int>>> futures;
+        for (int i = 0; i < 3; i++)
+        {
+            futures.push_back(resolver.resolve(RESOLVER_HOSTNAME, 2, hints));
+        }
+        ASSERT_EQ(1, resolver.getPendingCount());
+        ASSERT_EQ(2, resolver.getCoalescedCount());
+
+        unblock.set_value();
+        for (std::shared_future<std::pair<std::vector<SocketAddress>, int>>& future : futures)
+        {
+            ASSERT_EQ(0, future.get().second);
+            ASSERT_EQ(2, getPortNumber(future.get().first.front()));
+        }
+        ASSERT_EQ(2, resolver.getLookupCount());
+        ASSERT_EQ(0, resolver.getPendingCount());
+    }
+}
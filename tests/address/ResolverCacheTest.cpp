@@ -0,0 +1,120 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../../src/address/ResolverCache.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+#include "../../src/socket/TCPSocket.h"
+
+namespace kt
+{
+    const std::string LOCALHOST_NAME = "localhost";
+
+    /*
+     * Ensure a repeated lookup is answered from the cache with the same addresses as the resolver.
+     */
+    TEST(ResolverCacheTest, TestResolveHit)
+    {
+        ResolverCache cache;
+        const addrinfo hints = createTcpHints(InternetProtocolVersion::IPV4);
+        std::pair<std::vector<SocketAddress>, int> first = cache.resolve(LOCALHOST_NAME, 8080, hints);
+        std::pair<std::vector<SocketAddress>, int> second = cache.resolve(LOCALHOST_NAME, 8080, hints);
+        std::pair<std::vector<SocketAddress>, int> uncached = resolveToAddressesUncached(LOCALHOST_NAME, 8080, hints);
+
+        ASSERT_EQ(0, first.second);
+        ASSERT_EQ(uncached.first.size(), second.first.size());
+        ASSERT_EQ(getAddress(uncached.first.front()), getAddress(second.first.front()));
+        ASSERT_EQ(8080, getPortNumber(second.first.front()));
+        ASSERT_EQ(1, cache.getMissCount());
+        ASSERT_EQ(1, cache.getHitCount());
+
+        // A different port or different hints are separate entries
+        cache.resolve(LOCALHOST_NAME, 8081, hints);
+        cache.resolve(LOCALHOST_NAME, 8080, createUdpHints(InternetProtocolVersion::IPV4));
+        ASSERT_EQ(3, cache.getMissCount());
+        ASSERT_EQ(3, cache.size());
+
+        cache.invalidate(LOCALHOST_NAME);
+        ASSERT_EQ(0, cache.size());
+    }
+
+    /*
+     * Ensure a name that does not exist is cached for the negative time to live.
+     */
+    TEST(ResolverCacheTest, TestNegativeCaching)
+    {
+        ResolverCache cache(30000000, 20000);
+        const addrinfo hints = createTcpHints(InternetProtocolVersion::IPV4, AI_NUMERICHOST);
+        std::pair<std::vector<SocketAddress>, int> first = cache.resolve("not-a-number", 80, hints);
+        ASSERT_NE(0, first.second);
+        ASSERT_TRUE(first.first.empty());
+
+        ASSERT_EQ(first.second, cache.resolve("not-a-number", 80, hints).second);
+        ASSERT_EQ(1, cache.getHitCount());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        ASSERT_EQ(first.second, cache.resolve("not-a-number", 80, hints).second);
+        ASSERT_EQ(2, cache.getMissCount());
+
+        ResolverCache disabled(30000000, 0);
+        disabled.resolve("not-a-number", 80, hints);
+        ASSERT_EQ(0, disabled.size());
+    }
+
+    /*
+     * Ensure entries expire after the time to live and are refreshed before it while they are still used.
+     */
+    TEST(ResolverCacheTest, TestExpiryAndRefresh)
+    {
+        ResolverCache cache(20000);
+        const addrinfo hints = createTcpHints(InternetProtocolVersion::IPV4);
+        cache.resolve(LOCALHOST_NAME, 80, hints);
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        cache.resolve(LOCALHOST_NAME, 80, hints);
+        ASSERT_EQ(2, cache.getMissCount());
+
+        // Used since the last resolve, so it is resolved again. Unused afterwards, so it is removed once expired
+        ASSERT_EQ(1, cache.refresh(1000000));
+        ASSERT_EQ(1, cache.getRefreshCount());
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        ASSERT_EQ(0, cache.refresh(1000000));
+        ASSERT_EQ(0, cache.size());
+
+        ResolverCache refreshing(200000);
+        refreshing.resolve(LOCALHOST_NAME, 80, hints);
+        refreshing.startRefreshing(50000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        refreshing.resolve(LOCALHOST_NAME, 80, hints);
+        refreshing.stopRefreshing();
+        ASSERT_EQ(1, refreshing.getMissCount());
+        ASSERT_EQ(1, refreshing.getHitCount());
+        ASSERT_LE(1, refreshing.getRefreshCount());
+    }
+
+    /*
+     * Ensure sockets resolve through the installed cache.
+     */
+    TEST(ResolverCacheTest, TestInstalledCache)
+    {
+        TCPServerSocket serverSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4);
+        std::shared_ptr<ResolverCache> cache = std::make_shared<ResolverCache>();
+        setResolverCache(cache);
+        ASSERT_EQ(cache, getResolverCache());
+
+        for (int i = 0; i < 3; i++)
+        {
+            TCPSocket socket(LOCALHOST_NAME, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+            TCPSocket server = serverSocket.accept(1000000);
+            socket.close();
+            server.close();
+        }
+        setResolverCache(nullptr);
+
+        ASSERT_EQ(1, cache->getMissCount());
+        ASSERT_EQ(2, cache->getHitCount());
+        serverSocket.close();
+    }
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <optional>
+#include <string>
 #include <vector>
+#include <cstring>
 
 #include "../../src/socketexceptions/SocketError.h"
 #include "../../src/address/SocketAddress.h"
@@ -254,4 +256,45 @@ namespace kt
 		ASSERT_NE(&address, &copiedAddress);
 		ASSERT_EQ(0, std::memcmp(&address, &copiedAddress, sizeof(address)));
 	}
+
+	/**
+	* Ensure formatAddress() produces the same text as inet_ntop() for both versions, including compressed and IPv4-mapped forms.
+	*/
+	TEST(SocketAddressTest, SocketAddressFormatAddress_MatchesInetNtop)
+	{
+		const std::vector<std::string> ipv4Addresses = { "0.0.0.0", "127.0.0.1", "10.0.3.7", "255.255.255.255", "1.20.199.250" };
+		for (const std::string& text : ipv4Addresses)
+		{
+			kt::SocketAddress address{};
+			address.ipv4.sin_family = AF_INET;
+			ASSERT_EQ(1, inet_pton(AF_INET, text.c_str(), &address.ipv4.sin_addr));
+
+			char expected[INET_ADDRSTRLEN];
+			char formatted[INET6_ADDRSTRLEN];
+			ASSERT_NE(nullptr, inet_ntop(AF_INET, &address.ipv4.sin_addr, expected, sizeof(expected)));
+			ASSERT_EQ(std::strlen(expected), kt::formatAddress(address, formatted, sizeof(formatted)));
+			ASSERT_STREQ(expected, formatted);
+		}
+
+		const std::vector<std::string> ipv6Addresses = { "::", "::1", "1::", "2001:db8::7", "2001:db8:0:0:1:0:0:1", "fe80::1:0:0:0", "1:0:2:0:3:0:4:0",
+			"1:2:3:4:5:6:7:8", "::ffff:10.0.3.7", "::10.0.3.7", "::ffff:0:0", "0:0:0:0:0:1:0:0", "abcd:ef01:2345:6789:abcd:ef01:2345:6789", "0:1::" };
+		for (const std::string& text : ipv6Addresses)
+		{
+			kt::SocketAddress address{};
+			address.ipv6.sin6_family = AF_INET6;
+			ASSERT_EQ(1, inet_pton(AF_INET6, text.c_str(), &address.ipv6.sin6_addr));
+
+			char expected[INET6_ADDRSTRLEN];
+			char formatted[INET6_ADDRSTRLEN];
+			ASSERT_NE(nullptr, inet_ntop(AF_INET6, &address.ipv6.sin6_addr, expected, sizeof(expected)));
+			ASSERT_EQ(std::strlen(expected), kt::formatAddress(address, formatted, sizeof(formatted))) << text;
+			ASSERT_STREQ(expected, formatted);
+		}
+
+		kt::SocketAddress address{};
+		char formatted[4];
+		ASSERT_EQ(0, kt::formatAddress(address, formatted, sizeof(formatted)));
+		address.ipv4.sin_family = AF_INET;
+		ASSERT_EQ(0, kt::formatAddress(address, formatted, sizeof(formatted)));
+	}
 }
@@ -0,0 +1,134 @@
+#include <string>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#if defined(CPPSOCKETLIBRARY_COROUTINES) && defined(__linux__)
+
+#include "../../src/eventloop/CoroutineScheduler.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/socket/UDPSocket.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+
+const std::string LOCALHOST = "localhost";
+
+namespace kt
+{
+    class CoroutineSchedulerTest : public ::testing::Test
+    {
+    protected:
+        TCPServerSocket serverSocket;
+        CoroutineScheduler scheduler;
+
+    protected:
+        CoroutineSchedulerTest() : serverSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4), scheduler() { }
+        void TearDown() override
+        {
+            serverSocket.close();
+        }
+    };
+
+    /*
+     * Ensure a straight-line handler can accept, receive and reply without blocking the scheduler thread.
+     */
+    TEST_F(CoroutineSchedulerTest, CoroutineSchedulerEchoHandler)
+    {
+        scheduler.spawn([](CoroutineScheduler& scheduler, TCPServerSocket& serverSocket) -> Task<void>
+        {
+            TCPSocket client = co_await scheduler.acceptAsync(serverSocket);
+            char buffer[4];
+            int received = co_await scheduler.receiveAmountAsync(client, buffer, sizeof(buffer));
+            co_await scheduler.sendAsync(client, buffer, received);
+            client.close();
+        }(scheduler, serverSocket));
+        ASSERT_EQ(1, scheduler.getActiveTaskCount());
+
+        TCPSocket socket(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        const std::string testString = "test";
+        ASSERT_EQ(testString.size(), socket.send(testString));
+
+        scheduler.run();
+        ASSERT_EQ(0, scheduler.getActiveTaskCount());
+        ASSERT_EQ(testString, socket.receiveAmount(testString.size()));
+
+        socket.close();
+    }
+
+    /*
+     * Ensure a send larger than the socket buffers suspends until the receiving coroutine has drained enough of it.
+     */
+    TEST_F(CoroutineSchedulerTest, CoroutineSchedulerLargeTransfer)
+    {
+        TCPSocket socket(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        TCPSocket server = serverSocket.accept();
+
+        const std::string payload(8 * 1024 * 1024, 'c');
+        std::string received(payload.size(), '\0');
+        int sent = 0;
+        int receivedAmount = 0;
+
+        scheduler.spawn([](CoroutineScheduler& scheduler, TCPSocket& socket, const std::string& payload, int& sent) -> Task<void>
+        {
+            sent = co_await scheduler.sendAsync(socket, payload.data(), static_cast<int>(payload.size()));
+        }(scheduler, socket, payload, sent));
+        scheduler.spawn([](CoroutineScheduler& scheduler, TCPSocket& server, std::string& received, int& receivedAmount) -> Task<void>
+        {
+            receivedAmount = co_await scheduler.receiveAmountAsync(server, &received[0], static_cast<int>(received.size()));
+        }(scheduler, server, received, receivedAmount));
+
+        scheduler.run();
+        ASSERT_EQ(payload.size(), sent);
+        ASSERT_EQ(payload.size(), receivedAmount);
+        ASSERT_EQ(payload, received);
+
+        server.close();
+        socket.close();
+    }
+
+    /*
+     * Ensure a datagram receive waits for the datagram to arrive.
+     */
+    TEST_F(CoroutineSchedulerTest, CoroutineSchedulerReceiveFrom)
+    {
+        UDPSocket udpSocket;
+        ASSERT_EQ(0, udpSocket.bind(InternetProtocolVersion::IPV4).first);
+
+        std::string received;
+        scheduler.spawn([](CoroutineScheduler& scheduler, UDPSocket& udpSocket, std::string& received) -> Task<void>
+        {
+            char buffer[32];
+            std::pair<int, SocketAddress> result = co_await scheduler.receiveFromAsync(udpSocket, buffer, sizeof(buffer));
+            received.assign(buffer, result.first);
+        }(scheduler, udpSocket, received));
+        ASSERT_EQ(0, scheduler.poll(0));
+
+        UDPSocket client;
+        const std::string testString = "datagram";
+        ASSERT_EQ(testString.size(), client.sendTo(LOCALHOST, udpSocket.getListeningPort().value(), testString, 0, InternetProtocolVersion::IPV4).first);
+
+        scheduler.run();
+        ASSERT_EQ(testString, received);
+
+        udpSocket.close();
+    }
+
+    /*
+     * Ensure an exception escaping a spawned task is rethrown from run().
+     */
+    TEST_F(CoroutineSchedulerTest, CoroutineSchedulerTaskException)
+    {
+        scheduler.spawn([](CoroutineScheduler& scheduler, TCPServerSocket& serverSocket) -> Task<void>
+        {
+            co_await scheduler.readable(serverSocket.getSocket());
+            throw std::runtime_error("handler failed");
+        }(scheduler, serverSocket));
+
+        TCPSocket socket(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        ASSERT_THROW(scheduler.run(), std::runtime_error);
+        ASSERT_EQ(0, scheduler.getActiveTaskCount());
+
+        socket.close();
+    }
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/eventloop/EventLoop.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+#include "../../src/socketexceptions/SocketException.hpp"
+
+const std::string LOCALHOST = "localhost";
+
+namespace kt
+{
+#ifdef __linux__
+    class EventLoopTest : public ::testing::Test
+    {
+    protected:
+        TCPServerSocket serverSocket;
+        TCPSocket socket;
+        EventLoop loop;
+
+    protected:
+        EventLoopTest() : serverSocket(), socket(LOCALHOST, serverSocket.getPort()), loop() { }
+        void TearDown() override
+        {
+            loop.close();
+            socket.close();
+            serverSocket.close();
+        }
+    };
+
+    /*
+     * Ensure a registered server socket is notified as readable when a client is waiting to be accepted.
+     */
+    TEST_F(EventLoopTest, EventLoopServerSocketReadable)
+    {
+        std::vector<TCPSocket> accepted;
+        loop.add(serverSocket, SocketEvent::Read, [&](SOCKET, SocketEvent events) {
+            ASSERT_TRUE(hasEvent(events, SocketEvent::Read));
+            accepted.push_back(serverSocket.accept());
+        });
+
+        ASSERT_EQ(1, loop.poll(1000000));
+        ASSERT_EQ(1, accepted.size());
+        ASSERT_EQ(0, loop.poll(0));
+
+        accepted.at(0).close();
+    }
+
+    /*
+     * Ensure read callbacks are only dispatched for sockets with data and that removed sockets are no longer dispatched.
+     */
+    TEST_F(EventLoopTest, EventLoopReadAndRemove)
+    {
+        TCPSocket server = serverSocket.accept();
+        std::string received;
+        loop.add(server, SocketEvent::Read, [&](SOCKET, SocketEvent) {
+            received += server.receiveAmount(4);
+        });
+
+        ASSERT_EQ(1, loop.size());
+        ASSERT_TRUE(loop.contains(server.getSocket()));
+        ASSERT_EQ(0, loop.poll(0));
+
+        const std::string testString = "test";
+        ASSERT_EQ(socket.send(testString), testString.size());
+        ASSERT_EQ(1, loop.poll(1000000));
+        ASSERT_EQ(testString, received);
+
+        loop.remove(server.getSocket());
+        ASSERT_FALSE(loop.contains(server.getSocket()));
+        ASSERT_EQ(socket.send(testString), testString.size());
+        ASSERT_EQ(0, loop.poll(1000));
+        ASSERT_EQ(testString, received);
+
+        server.close();
+    }
+
+    /*
+     * Ensure that write readiness can be requested and later turned off through modify().
+     */
+    TEST_F(EventLoopTest, EventLoopWriteAndModify)
+    {
+        int writable = 0;
+        loop.add(socket, SocketEvent::Write, [&](SOCKET, SocketEvent events) {
+            if (hasEvent(events, SocketEvent::Write))
+            {
+                writable++;
+            }
+        });
+
+        ASSERT_EQ(1, loop.poll(1000000));
+        ASSERT_EQ(1, writable);
+
+        loop.modify(socket.getSocket(), SocketEvent::Read);
+        ASSERT_EQ(0, loop.poll(0));
+        ASSERT_EQ(1, writable);
+    }
+
+    /*
+     * Ensure the remote closing the connection is reported as a Closed event.
+     */
+    TEST_F(EventLoopTest, EventLoopClosedEvent)
+    {
+        TCPSocket server = serverSocket.accept();
+        SocketEvent received = SocketEvent::None;
+        loop.add(server, SocketEvent::Read, [&](SOCKET, SocketEvent events) {
+            received = events;
+        });
+
+        socket.close();
+        ASSERT_EQ(1, loop.poll(1000000));
+        ASSERT_TRUE(hasEvent(received, SocketEvent::Closed));
+
+        server.close();
+    }
+
+    /*
+     * Ensure UDP sockets can be registered by their listening socket.
+     */
+    TEST_F(EventLoopTest, EventLoopUDPSocket)
+    {
+        UDPSocket udpSocket;
+        ASSERT_EQ(0, udpSocket.bind(InternetProtocolVersion::IPV4).first);
+
+        bool notified = false;
+        loop.add(udpSocket, SocketEvent::Read, [&](SOCKET, SocketEvent) {
+            notified = true;
+        });
+
+        UDPSocket client;
+        const std::string testString = "test";
+        ASSERT_EQ(testString.size(), client.sendTo(LOCALHOST, udpSocket.getListeningPort().value(), testString, 0, InternetProtocolVersion::IPV4).first);
+        ASSERT_EQ(1, loop.poll(1000000));
+        ASSERT_TRUE(notified);
+
+        udpSocket.close();
+    }
+
+    /*
+     * Ensure registering an invalid or already registered socket throws.
+     */
+    TEST_F(EventLoopTest, EventLoopInvalidRegistration)
+    {
+        EventLoop::Callback callback = [](SOCKET, SocketEvent) {};
+        ASSERT_THROW(loop.add(getInvalidSocketValue(), SocketEvent::Read, callback), SocketException);
+
+        loop.add(socket, SocketEvent::Read, callback);
+        ASSERT_THROW(loop.add(socket, SocketEvent::Read, callback), SocketException);
+        ASSERT_THROW(loop.modify(serverSocket.getSocket(), SocketEvent::Read), SocketException);
+    }
+
+    /*
+     * Ensure that stop() wakes up a thread blocked inside run().
+     */
+    TEST_F(EventLoopTest, EventLoopStopFromAnotherThread)
+    {
+        std::thread runner([&]() {
+            loop.run();
+        });
+
+        while (!loop.isRunning())
+        {
+            std::this_thread::yield();
+        }
+        loop.stop();
+        runner.join();
+
+        ASSERT_FALSE(loop.isRunning());
+    }
+
+    /*
+     * Ensure a stop() made before the thread calling run() has started is not lost.
+     */
+    TEST_F(EventLoopTest, EventLoopStopBeforeRun)
+    {
+        loop.stop();
+        std::future<void> runner = std::async(std::launch::async, [&]() {
+            loop.run();
+        });
+
+        const bool returned = runner.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+        if (!returned)
+        {
+            loop.stop();
+        }
+        runner.get();
+        ASSERT_TRUE(returned);
+        ASSERT_FALSE(loop.isRunning());
+    }
+#endif
+}
@@ -0,0 +1,218 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/eventloop/IOUringEngine.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/socket/UDPSocket.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+#include "../../src/socketexceptions/SocketException.hpp"
+
+#ifdef CPPSOCKETLIBRARY_IO_URING
+
+#include <sys/socket.h>
+
+#endif
+
+const std::string LOCALHOST = "localhost";
+
+namespace kt
+{
+#ifdef CPPSOCKETLIBRARY_IO_URING
+    class IOUringEngineTest : public ::testing::Test
+    {
+    protected:
+        TCPServerSocket serverSocket;
+        std::unique_ptr<IOUringEngine> engine;
+
+    protected:
+        IOUringEngineTest() : serverSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4) { }
+        void SetUp() override
+        {
+            try
+            {
+                engine = std::make_unique<IOUringEngine>(32, 8, 1024);
+            }
+            catch (const SocketException& ex)
+            {
+                // The build supports io_uring but the running kernel (or sandbox) may not
+                GTEST_SKIP() << ex.what();
+            }
+        }
+        void TearDown() override
+        {
+            if (engine != nullptr)
+            {
+                engine->close();
+            }
+            serverSocket.close();
+        }
+
+        std::vector<IOUringCompletion> waitForCompletions(const size_t& amount)
+        {
+            std::vector<IOUringCompletion> completions;
+            while (completions.size() < amount)
+            {
+                EXPECT_GE(engine->submitAndWait(1), 0);
+                engine->drainCompletions(completions);
+            }
+            return completions;
+        }
+    };
+
+    /*
+     * Ensure a single multishot accept produces a completion for every connection and that pooled receives return the sent data.
+     */
+    TEST_F(IOUringEngineTest, IOUringEngineMultishotAcceptAndPooledReceive)
+    {
+        engine->acceptMultishot(serverSocket, 1);
+        ASSERT_EQ(1, engine->submit());
+
+        TCPSocket first(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        TCPSocket second(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+
+        std::vector<IOUringCompletion> completions = waitForCompletions(2);
+        ASSERT_EQ(2, completions.size());
+        for (const IOUringCompletion& completion : completions)
+        {
+            ASSERT_EQ(IOUringOperation::Accept, completion.operation);
+            ASSERT_EQ(1, completion.userData);
+            ASSERT_GE(completion.result, 0);
+            ASSERT_TRUE(completion.more);
+        }
+
+        TCPSocket server = engine->toTCPSocket(completions.at(0), serverSocket);
+        TCPSocket otherServer = engine->toTCPSocket(completions.at(1), serverSocket);
+
+        const std::string testString = "io_uring";
+        ASSERT_EQ(testString.size(), first.send(testString));
+        ASSERT_EQ(testString.size(), second.send(testString));
+        engine->receive(server, 2);
+        engine->receive(otherServer, 3);
+
+        completions = waitForCompletions(2);
+        ASSERT_EQ(2, completions.size());
+        for (const IOUringCompletion& completion : completions)
+        {
+            ASSERT_EQ(IOUringOperation::Receive, completion.operation);
+            ASSERT_EQ(testString.size(), completion.result);
+            ASSERT_TRUE(completion.bufferId.has_value());
+            ASSERT_EQ(testString, std::string(engine->getReceiveBuffer(completion.bufferId.value()), completion.result));
+            engine->releaseReceiveBuffer(completion.bufferId.value());
+        }
+        ASSERT_NE(completions.at(0).bufferId, completions.at(1).bufferId);
+
+        server.close();
+        otherServer.close();
+        first.close();
+        second.close();
+    }
+
+    /*
+     * Ensure batched sends and receives into caller provided buffers complete with the transferred sizes.
+     */
+    TEST_F(IOUringEngineTest, IOUringEngineSendAndReceive)
+    {
+        TCPSocket client(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        TCPSocket server = serverSocket.accept();
+
+        const std::string testString = "batched";
+        char buffer[16];
+        engine->send(client, testString.data(), static_cast<unsigned int>(testString.size()), 10);
+        engine->receive(server, buffer, sizeof(buffer), 11);
+
+        std::vector<IOUringCompletion> completions = waitForCompletions(2);
+        ASSERT_EQ(2, completions.size());
+        for (const IOUringCompletion& completion : completions)
+        {
+            ASSERT_EQ(testString.size(), completion.result);
+            ASSERT_FALSE(completion.bufferId.has_value());
+            if (completion.userData == 10)
+            {
+                ASSERT_EQ(IOUringOperation::Send, completion.operation);
+            }
+            else
+            {
+                ASSERT_EQ(11, completion.userData);
+                ASSERT_EQ(IOUringOperation::Receive, completion.operation);
+            }
+        }
+        ASSERT_EQ(testString, std::string(buffer, testString.size()));
+
+        server.close();
+        client.close();
+    }
+
+    /*
+     * Ensure datagrams can be sent and received between bound UDP sockets using message headers.
+     */
+    TEST_F(IOUringEngineTest, IOUringEngineUDPMessages)
+    {
+        UDPSocket receiver;
+        UDPSocket sender;
+        ASSERT_EQ(0, receiver.bind(InternetProtocolVersion::IPV4).first);
+        ASSERT_EQ(0, sender.bind(InternetProtocolVersion::IPV4).first);
+
+        std::string testString = "datagram";
+        std::pair<std::optional<SocketAddress>, int> receiverAddress = socketToAddress(receiver.getListeningSocket());
+        ASSERT_TRUE(receiverAddress.first.has_value());
+        SocketAddress destination = receiverAddress.first.value();
+        iovec sendVector{ &testString[0], testString.size() };
+        msghdr sendHeader{};
+        sendHeader.msg_name = &destination;
+        sendHeader.msg_namelen = getAddressLength(destination);
+        sendHeader.msg_iov = &sendVector;
+        sendHeader.msg_iovlen = 1;
+
+        char buffer[32];
+        SocketAddress source{};
+        iovec receiveVector{ buffer, sizeof(buffer) };
+        msghdr receiveHeader{};
+        receiveHeader.msg_name = &source;
+        receiveHeader.msg_namelen = sizeof(source);
+        receiveHeader.msg_iov = &receiveVector;
+        receiveHeader.msg_iovlen = 1;
+
+        engine->receiveMessage(receiver, &receiveHeader, 20);
+        engine->sendMessage(sender, &sendHeader, 21);
+
+        std::vector<IOUringCompletion> completions = waitForCompletions(2);
+        ASSERT_EQ(2, completions.size());
+        for (const IOUringCompletion& completion : completions)
+        {
+            ASSERT_EQ(testString.size(), completion.result);
+        }
+        ASSERT_EQ(testString, std::string(buffer, testString.size()));
+        ASSERT_EQ(sender.getListeningPort().value(), getPortNumber(source));
+
+        receiver.close();
+        sender.close();
+    }
+
+    /*
+     * Ensure invalid operations are rejected before they are queued.
+     */
+    TEST_F(IOUringEngineTest, IOUringEngineInvalidOperations)
+    {
+        ASSERT_THROW(engine->accept(serverSocket, static_cast<uint64_t>(1) << 56), SocketException);
+
+        UDPSocket unbound;
+        msghdr header{};
+        ASSERT_THROW(engine->receiveMessage(unbound, &header, 1), SocketException);
+        ASSERT_EQ(nullptr, engine->getReceiveBuffer(8));
+
+        engine->close();
+        ASSERT_THROW(engine->accept(serverSocket, 1), SocketException);
+    }
+#else
+    /*
+     * Ensure the engine reports that it is unavailable when built without io_uring support.
+     */
+    TEST(IOUringEngineTest, IOUringEngineUnsupported)
+    {
+        ASSERT_THROW(IOUringEngine engine, SocketException);
+    }
+#endif
+}
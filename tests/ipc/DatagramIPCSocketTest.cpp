@@ -200,5 +200,58 @@ TEST(DatagramIPCSocketTest, WindowsConstructorThrows)
         while(!socket.ready()) {}
         ASSERT_TRUE(socket.ready());
     }
+
+    /*
+     * Ensure that with send socket caching enabled multiple sends reuse the same socket, so the pre-send operation is only run once.
+     */
+    TEST_F(DatagramIPCSocketTest, DatagramIPCSendTo_CachedSendSocket)
+    {
+        ASSERT_EQ(0, socket.bind(SOCKET_PATH).first);
+
+        DatagramIPCSocket client;
+        int createdSockets = 0;
+        client.setPreSendSocketOperation([&createdSockets](SOCKET&) { createdSockets++; });
+        client.setSendSocketCaching(true);
+        ASSERT_TRUE(client.isSendSocketCachingEnabled());
+
+        const std::string message = "cached";
+        for (int i = 0; i < 3; i++)
+        {
+            ASSERT_EQ(message.size(), client.sendTo(SOCKET_PATH, message));
+            while(!socket.ready()) {}
+            ASSERT_EQ(message, socket.receiveFrom(message.size()).first.value());
+        }
+        ASSERT_EQ(1, createdSockets);
+
+        client.setSendSocketCaching(false);
+        ASSERT_EQ(message.size(), client.sendTo(SOCKET_PATH, message));
+        ASSERT_EQ(2, createdSockets);
+
+        client.close();
+    }
+
+    /*
+     * Ensure a connected DatagramIPCSocket can send to its fixed path with send() and that disconnect() stops this.
+     */
+    TEST_F(DatagramIPCSocketTest, DatagramIPCConnectAndSend)
+    {
+        DatagramIPCSocket client;
+        ASSERT_NE(0, client.connect(SOCKET_PATH));
+        ASSERT_FALSE(client.isConnected());
+
+        ASSERT_EQ(0, socket.bind(SOCKET_PATH).first);
+        ASSERT_EQ(0, client.connect(SOCKET_PATH));
+        ASSERT_TRUE(client.isConnected());
+        ASSERT_EQ(SOCKET_PATH, client.getConnectedPath().value());
+
+        const std::string message = "connected";
+        ASSERT_EQ(message.size(), client.send(message));
+        while(!socket.ready()) {}
+        ASSERT_EQ(message, socket.receiveFrom(message.size()).first.value());
+
+        client.disconnect();
+        ASSERT_FALSE(client.isConnected());
+        ASSERT_EQ(-1, client.send(message));
+    }
 #endif
 }
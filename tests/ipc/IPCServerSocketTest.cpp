@@ -1,3 +1,5 @@
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "../../src/ipc/IPCServerSocket.h"
@@ -5,6 +7,12 @@
 #include "../../src/socketexceptions/BindingException.hpp"
 #include "../../src/socketexceptions/TimeoutException.hpp"
 
+#ifndef _WIN32
+
+#include <fcntl.h>
+
+#endif
+
 const std::string SOCKET_PATH = "/tmp/IPCServerSocketTest.sock";
 
 namespace kt
@@ -86,4 +94,70 @@ namespace kt
         std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
         ASSERT_GE(1, std::chrono::duration_cast<std::chrono::seconds>(end - start).count());
     }
+
+    /*
+     * Ensure that a connection can be accepted directly into non-blocking mode.
+     */
+    TEST_F(IPCServerSocketTest, TestAcceptNonBlocking)
+    {
+        StreamIPCSocket client(SOCKET_PATH);
+        StreamIPCSocket serverClient = serverSocket.accept(0, true);
+        ASSERT_TRUE(serverClient.isNonBlocking());
+        ASSERT_FALSE(client.isNonBlocking());
+
+        char buffer[4];
+        ASSERT_EQ(IOStatus::WouldBlock, serverClient.receivePartial(buffer, sizeof(buffer)).second);
+
+        serverClient.close();
+        client.close();
+    }
+
+    /*
+     * Ensure every queued connection is accepted in one call with the requested flags.
+     */
+    TEST_F(IPCServerSocketTest, TestAcceptMany)
+    {
+        IPCServerSocket server("/tmp/IPCServerSocketTestAcceptMany.sock", true, 8);
+        std::vector<StreamIPCSocket> clients;
+        for (int i = 0; i < 3; i++)
+        {
+            clients.emplace_back("/tmp/IPCServerSocketTestAcceptMany.sock");
+        }
+
+        std::vector<StreamIPCSocket> accepted = server.acceptMany(8, 1000000, true, true);
+        ASSERT_EQ(3, accepted.size());
+        for (StreamIPCSocket& socket : accepted)
+        {
+            ASSERT_TRUE(socket.isNonBlocking());
+#ifndef _WIN32
+            ASSERT_NE(0, fcntl(socket.getSocket(), F_GETFD) & FD_CLOEXEC);
+#endif
+            socket.close();
+        }
+        ASSERT_THROW(server.acceptMany(8, 10000), TimeoutException);
+
+        for (StreamIPCSocket& client : clients)
+        {
+            client.close();
+        }
+        server.close();
+    }
+
+    /*
+     * Ensure tryAccept() reports a timeout through its result and otherwise returns the accepted connection.
+     */
+    TEST_F(IPCServerSocketTest, TestTryAccept)
+    {
+        Result<StreamIPCSocket> result = serverSocket.tryAccept(10000);
+        ASSERT_FALSE(result);
+        ASSERT_EQ(ResultError::Timeout, result.getError());
+
+        StreamIPCSocket client(SOCKET_PATH);
+        result = serverSocket.tryAccept(1000000);
+        ASSERT_TRUE(result);
+        ASSERT_TRUE(result.value().connected());
+
+        result.value().close();
+        client.close();
+    }
 }
@@ -1,4 +1,7 @@
+#include <cstdio>
+#include <fstream>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -7,6 +10,7 @@
 
 #include "../../src/socketexceptions/SocketError.h"
 #include "../../src/socketexceptions/SocketException.hpp"
+#include "../../src/socketexceptions/TimeoutException.hpp"
 
 const std::string SOCKET_PATH = "/tmp/StreamIPCSocketTest.sock";
 
@@ -35,6 +39,55 @@ namespace kt
         ASSERT_FALSE(kt::isInvalidSocket(socket.getSocket()));
     }
 
+    /*
+     * Ensure the connect with timeout constructor connects and leaves the socket in blocking mode.
+     */
+    TEST_F(StreamIPCSocketTest, IPCConstructorWithTimeout)
+    {
+        // The fixture's server has a backlog of 0, so its queued connection must be accepted first
+        StreamIPCSocket server = serverSocket.accept();
+        StreamIPCSocket timed(SOCKET_PATH, 1000000);
+        ASSERT_TRUE(timed.connected());
+        ASSERT_FALSE(timed.isNonBlocking());
+        ASSERT_EQ(SOCKET_PATH, timed.getSocketPath());
+
+        ASSERT_THROW({
+            StreamIPCSocket missing("/tmp/StreamIPCSocketTest-missing.sock", 1000000);
+        }, SocketException);
+
+        server.close();
+        timed.close();
+    }
+
+    /*
+     * Ensure a TimeoutException is thrown when the listener's backlog stays full for the whole timeout.
+     */
+    TEST_F(StreamIPCSocketTest, IPCConstructorWithTimeout_BacklogFull)
+    {
+        const std::string fullPath = "/tmp/StreamIPCSocketTest-full.sock";
+        IPCServerSocket fullServer(fullPath, true, 1);
+        std::vector<StreamIPCSocket> queued;
+        bool timedOut = false;
+        for (int i = 0; i < 16 && !timedOut; i++)
+        {
+            try
+            {
+                queued.emplace_back(fullPath, 50000);
+            }
+            catch (const TimeoutException&)
+            {
+                timedOut = true;
+            }
+        }
+        ASSERT_TRUE(timedOut);
+
+        for (StreamIPCSocket& client : queued)
+        {
+            client.close();
+        }
+        fullServer.close();
+    }
+
     /*
      * Ensure that a Socket created from the copy constructor is still able to send and receive from the copied socket.
      */
@@ -163,4 +216,31 @@ namespace kt
         ASSERT_FALSE(socket.connected());
         server.close();
     }
+
+    /*
+     * Ensure part of a file can be sent over a unix domain socket.
+     */
+    TEST_F(StreamIPCSocketTest, TestSendFile)
+    {
+        const std::string path = "/tmp/StreamIPCSocketTestSendFile.txt";
+        const std::string content = "header|body of the file|trailer";
+        std::ofstream(path, std::ios::binary) << content;
+        StreamIPCSocket server = serverSocket.accept();
+
+        std::pair<size_t, IOStatus> result = socket.sendFile(path, 7, 16);
+        ASSERT_EQ(16, result.first);
+        ASSERT_EQ(IOStatus::Complete, result.second);
+        ASSERT_EQ("body of the file", server.receiveAmount(16));
+
+        // Sending past the end of the file stops at the end
+        result = socket.sendFile(path, 24, 100);
+        ASSERT_EQ(7, result.first);
+        ASSERT_EQ(IOStatus::Complete, result.second);
+        ASSERT_EQ("trailer", server.receiveAmount(7));
+
+        ASSERT_EQ(IOStatus::Error, socket.sendFile("/tmp/StreamIPCSocketTestMissing.txt").second);
+
+        server.close();
+        std::remove(path.c_str());
+    }
 }
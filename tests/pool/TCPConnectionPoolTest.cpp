@@ -0,0 +1,170 @@
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../../src/pool/TCPConnectionPool.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/socketexceptions/SocketException.hpp"
+#include "../../src/socketexceptions/TimeoutException.hpp"
+
+const std::string LOCALHOST = "localhost";
+
+namespace kt
+{
+    class TCPConnectionPoolTest : public ::testing::Test
+    {
+    protected:
+        TCPServerSocket serverSocket;
+
+    protected:
+        TCPConnectionPoolTest() : serverSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4) {}
+        void TearDown() override
+        {
+            serverSocket.close();
+        }
+    };
+
+    /*
+     * Ensure a released connection is handed out again instead of opening a new one.
+     */
+    TEST_F(TCPConnectionPoolTest, TestLeaseReusesReleasedConnection)
+    {
+        TCPConnectionPool pool(2, 0, 0, 0, InternetProtocolVersion::IPV4);
+        TCPSocket socket = pool.lease(LOCALHOST, serverSocket.getPort());
+        TCPSocket server = serverSocket.accept(1000000);
+        ASSERT_EQ(1, pool.getTotalCount(LOCALHOST, serverSocket.getPort()));
+
+        const std::string request = "ping";
+        ASSERT_EQ(request.size(), socket.send(request));
+        ASSERT_EQ(request, server.receiveAmount(request.size()));
+        ASSERT_TRUE(pool.release(socket));
+        ASSERT_FALSE(pool.release(socket));
+        ASSERT_EQ(1, pool.getIdleCount(LOCALHOST, serverSocket.getPort()));
+
+        TCPSocket reused = pool.lease(LOCALHOST, serverSocket.getPort());
+        ASSERT_EQ(socket.getSocket(), reused.getSocket());
+        ASSERT_EQ(0, pool.getIdleCount(LOCALHOST, serverSocket.getPort()));
+        ASSERT_EQ(1, pool.getTotalCount(LOCALHOST, serverSocket.getPort()));
+        ASSERT_THROW(serverSocket.accept(10000), TimeoutException);
+
+        ASSERT_TRUE(pool.discard(reused));
+        ASSERT_EQ(0, pool.getTotalCount(LOCALHOST, serverSocket.getPort()));
+        server.close();
+        pool.close();
+    }
+
+    /*
+     * Ensure warming up opens the minimum amount of idle connections without exceeding the endpoint limit.
+     */
+    TEST_F(TCPConnectionPoolTest, TestWarmUp)
+    {
+        TCPConnectionPool pool(2, 3, 1000000, 0, InternetProtocolVersion::IPV4);
+        ASSERT_EQ(2, pool.warmUp(LOCALHOST, serverSocket.getPort()));
+        ASSERT_EQ(2, pool.getIdleCount(LOCALHOST, serverSocket.getPort()));
+        ASSERT_EQ(0, pool.warmUp(LOCALHOST, serverSocket.getPort()));
+
+        TCPSocket first = serverSocket.accept(1000000);
+        TCPSocket second = serverSocket.accept(1000000);
+
+        pool.close();
+        ASSERT_EQ(0, pool.getTotalCount(LOCALHOST, serverSocket.getPort()));
+        ASSERT_THROW(pool.lease(LOCALHOST, serverSocket.getPort()), SocketException);
+        first.close();
+        second.close();
+    }
+
+    /*
+     * Ensure a lease waits for a connection to be released once the endpoint is at its limit, and times out otherwise.
+     */
+    TEST_F(TCPConnectionPoolTest, TestLeaseWaitsAtLimit)
+    {
+        TCPConnectionPool pool(1, 0, 0, 0, InternetProtocolVersion::IPV4);
+        TCPSocket socket = pool.lease(LOCALHOST, serverSocket.getPort());
+        TCPSocket server = serverSocket.accept(1000000);
+
+        ASSERT_THROW(pool.lease(LOCALHOST, serverSocket.getPort(), 10000), TimeoutException);
+
+        std::thread releaser([&pool, &socket]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            pool.release(socket);
+        });
+        TCPSocket waited = pool.lease(LOCALHOST, serverSocket.getPort(), 2000000);
+        releaser.join();
+        ASSERT_EQ(socket.getSocket(), waited.getSocket());
+
+        pool.discard(waited);
+        server.close();
+        pool.close();
+    }
+
+    /*
+     * Ensure a release only wakes a caller waiting on the same endpoint, even when callers for another endpoint started waiting
+     * first.
+     */
+    TEST_F(TCPConnectionPoolTest, TestReleaseWakesWaiterOfSameEndpoint)
+    {
+        TCPServerSocket otherServerSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4);
+        TCPConnectionPool pool(1, 0, 0, 0, InternetProtocolVersion::IPV4);
+        TCPSocket socket = pool.lease(LOCALHOST, serverSocket.getPort());
+        TCPSocket server = serverSocket.accept(1000000);
+        TCPSocket otherSocket = pool.lease(LOCALHOST, otherServerSocket.getPort());
+        TCPSocket otherServer = otherServerSocket.accept(1000000);
+
+        std::future<TCPSocket> otherWaiter = std::async(std::launch::async, [this, &pool, &otherServerSocket]()
+        {
+            return pool.lease(LOCALHOST, otherServerSocket.getPort(), 5000000);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::future<TCPSocket> waiter = std::async(std::launch::async, [this, &pool]()
+        {
+            return pool.lease(LOCALHOST, serverSocket.getPort(), 5000000);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        pool.release(socket);
+        ASSERT_EQ(std::future_status::ready, waiter.wait_for(std::chrono::seconds(1)));
+        ASSERT_EQ(socket.getSocket(), waiter.get().getSocket());
+        ASSERT_EQ(std::future_status::timeout, otherWaiter.wait_for(std::chrono::milliseconds(0)));
+
+        pool.release(otherSocket);
+        ASSERT_EQ(otherSocket.getSocket(), otherWaiter.get().getSocket());
+
+        pool.discard(socket);
+        pool.discard(otherSocket);
+        server.close();
+        otherServer.close();
+        pool.close();
+        otherServerSocket.close();
+    }
+
+    /*
+     * Ensure an idle connection the peer has closed is replaced by a new connection when leased.
+     */
+    TEST_F(TCPConnectionPoolTest, TestLeaseReplacesClosedConnection)
+    {
+        TCPConnectionPool pool(1, 0, 0, 0, InternetProtocolVersion::IPV4);
+        TCPSocket socket = pool.lease(LOCALHOST, serverSocket.getPort());
+        TCPSocket server = serverSocket.accept(1000000);
+        pool.release(socket);
+
+        server.close();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        TCPSocket replacement = pool.lease(LOCALHOST, serverSocket.getPort());
+        TCPSocket newServer = serverSocket.accept(1000000);
+        ASSERT_EQ(1, pool.getTotalCount(LOCALHOST, serverSocket.getPort()));
+
+        const std::string request = "ping";
+        ASSERT_EQ(request.size(), replacement.send(request));
+        ASSERT_EQ(request, newServer.receiveAmount(request.size()));
+
+        pool.discard(replacement);
+        newServer.close();
+        pool.close();
+    }
+}
@@ -0,0 +1,234 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/server/TCPServer.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+#include "../../src/enums/IOStatus.h"
+
+#ifdef __linux__
+
+#include <ctime>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#endif
+
+const std::string LOCALHOST = "localhost";
+
+namespace kt
+{
+#ifdef __linux__
+    class TCPServerTest : public ::testing::Test
+    {
+    protected:
+        TCPServerSocket serverSocket;
+        std::atomic<int> closedNotifications{0};
+        TCPServer::Handler echoHandler;
+
+    protected:
+        TCPServerTest() : serverSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4)
+        {
+            echoHandler = [this](TCPSocket& socket, SocketEvent events)
+            {
+                char buffer[256];
+                std::pair<int, IOStatus> received = socket.receivePartial(buffer, sizeof(buffer));
+                if (received.first > 0)
+                {
+                    socket.send(buffer, received.first);
+                }
+                if (hasEvent(events, SocketEvent::Closed) || received.second == IOStatus::Closed)
+                {
+                    closedNotifications++;
+                    return SocketEvent::None;
+                }
+                return SocketEvent::Read;
+            };
+        }
+        void TearDown() override
+        {
+            serverSocket.close();
+        }
+
+        template <typename Predicate>
+        bool waitFor(const Predicate& predicate)
+        {
+            for (int i = 0; i < 200 && !predicate(); i++)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            return predicate();
+        }
+    };
+
+    /*
+     * Ensure connections spread across several workers are each served by the handler.
+     */
+    TEST_F(TCPServerTest, TCPServerEchoAcrossWorkers)
+    {
+        TCPServer server(serverSocket, echoHandler, 4);
+        ASSERT_EQ(4, server.getWorkerCount());
+        server.start();
+        ASSERT_TRUE(server.isRunning());
+
+        std::vector<TCPSocket> clients;
+        for (int i = 0; i < 8; i++)
+        {
+            clients.emplace_back(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        }
+        ASSERT_TRUE(waitFor([&]() { return server.getConnectionCount() == clients.size(); }));
+
+        for (size_t i = 0; i < clients.size(); i++)
+        {
+            const std::string message = "message " + std::to_string(i);
+            ASSERT_EQ(message.size(), clients[i].send(message));
+            ASSERT_EQ(message, clients[i].receiveAmount(message.size()));
+        }
+
+        for (TCPSocket& client : clients)
+        {
+            client.close();
+        }
+        ASSERT_TRUE(waitFor([&]() { return server.getConnectionCount() == 0; }));
+        ASSERT_EQ(clients.size(), closedNotifications);
+
+        server.stop();
+        ASSERT_FALSE(server.isRunning());
+    }
+
+    /*
+     * Ensure a connection whose handler is busy does not hold up other connections, including the ones owned by the same worker,
+     * which are picked up by the idle worker polling the busy worker's loop.
+     */
+    TEST_F(TCPServerTest, TCPServerSlowHandlerDoesNotBlockOtherConnections)
+    {
+        std::atomic<bool> release{false};
+        TCPServer server(serverSocket, [&](TCPSocket& socket, SocketEvent events)
+        {
+            char first = 0;
+            if (socket.receivePartial(&first, 1).first == 1 && first == 's')
+            {
+                while (!release)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                return SocketEvent::Read;
+            }
+            socket.send(&first, 1);
+            return hasEvent(events, SocketEvent::Closed) ? SocketEvent::None : SocketEvent::Read;
+        }, 2);
+        server.start();
+
+        // Round robin assignment gives the first and third connections to the same worker
+        TCPSocket slow(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        TCPSocket other(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        TCPSocket sameWorker(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        ASSERT_TRUE(waitFor([&]() { return server.getConnectionCount() == 3; }));
+
+        ASSERT_EQ(1, slow.send(std::string("s")));
+        ASSERT_EQ(1, other.send(std::string("o")));
+        const bool otherServed = other.ready(2000000);
+
+        // Sent while the slow handler is still blocked
+        ASSERT_EQ(1, sameWorker.send(std::string("w")));
+        const bool sameWorkerServed = sameWorker.ready(2000000);
+        const size_t stolen = server.getStolenNotificationCount();
+        release = true;
+
+        ASSERT_TRUE(otherServed);
+        ASSERT_EQ("o", other.receiveAmount(1));
+        ASSERT_TRUE(sameWorkerServed);
+        ASSERT_EQ("w", sameWorker.receiveAmount(1));
+        ASSERT_GT(stolen, 0);
+
+        server.stop();
+        ASSERT_EQ(0, server.getConnectionCount());
+
+        slow.close();
+        other.close();
+        sameWorker.close();
+    }
+
+    /*
+     * Ensure a handler returning None closes the connection and that stop() closes any remaining connections.
+     */
+    TEST_F(TCPServerTest, TCPServerHandlerClosesConnection)
+    {
+        TCPServer server(serverSocket, [](TCPSocket& socket, SocketEvent)
+        {
+            char buffer[8];
+            socket.receivePartial(buffer, sizeof(buffer));
+            return SocketEvent::None;
+        }, 2);
+        server.start();
+
+        TCPSocket closing(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        TCPSocket idle(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        ASSERT_TRUE(waitFor([&]() { return server.getConnectionCount() == 2; }));
+
+        ASSERT_EQ(4, closing.send(std::string("done")));
+        ASSERT_TRUE(waitFor([&]() { return server.getConnectionCount() == 1; }));
+        ASSERT_EQ("", closing.receiveAmount(1));
+
+        server.stop();
+        ASSERT_EQ(0, server.getConnectionCount());
+
+        // The server can be restarted with the same listening socket
+        server.start();
+        TCPSocket restarted(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        ASSERT_TRUE(waitFor([&]() { return server.getConnectionCount() == 1; }));
+        server.stop();
+
+        closing.close();
+        idle.close();
+        restarted.close();
+    }
+
+    /*
+     * Ensure the accept thread backs off instead of spinning while accepting fails because the process is out of descriptors, and
+     * accepts the waiting connection once descriptors are available again.
+     */
+    TEST_F(TCPServerTest, TCPServerBacksOffWhenOutOfDescriptors)
+    {
+        TCPServer server(serverSocket, echoHandler, 1);
+        server.start();
+
+        // Created up front since no new descriptor can be opened once the limit is lowered, connecting does not need one
+        const SOCKET client = ::socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_FALSE(isInvalidSocket(client));
+        const kt::SocketAddress address = serverSocket.getSocketAddress();
+
+        rlimit original{};
+        ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &original));
+        // Every descriptor below the lowest free one is in use, so a limit of that number makes the next accept fail with EMFILE
+        const int lowestFree = ::dup(client);
+        ::close(lowestFree);
+        rlimit lowered = original;
+        lowered.rlim_cur = static_cast<rlim_t>(lowestFree);
+        ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &lowered));
+
+        const int connected = ::connect(client, &address.address, kt::getAddressLength(address));
+        timespec start{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &start);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        timespec end{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &end);
+        const size_t connectionsWhileLimited = server.getConnectionCount();
+        ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &original));
+
+        ASSERT_EQ(0, connected);
+        ASSERT_EQ(0, connectionsWhileLimited);
+        const long cpuMilliseconds = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+        ASSERT_LT(cpuMilliseconds, 150);
+
+        ASSERT_TRUE(waitFor([&]() { return server.getConnectionCount() == 1; }));
+        server.stop();
+        ::close(client);
+    }
+#endif
+}
@@ -0,0 +1,111 @@
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/serversocket/ShardedTCPServerSocket.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/socketexceptions/BindingException.hpp"
+#include "../../src/socketexceptions/SocketException.hpp"
+#include "../../src/socketexceptions/TimeoutException.hpp"
+
+#ifndef _WIN32
+
+#include <poll.h>
+
+#endif
+
+namespace kt
+{
+#ifdef SO_REUSEPORT
+    class ShardedTCPServerSocketTest: public ::testing::Test
+    {
+    protected:
+        ShardedTCPServerSocket serverSocket;
+    protected:
+        ShardedTCPServerSocketTest() : serverSocket(4, std::nullopt, 0, 20, InternetProtocolVersion::IPV4) {}
+        void TearDown() override
+        {
+            serverSocket.close();
+        }
+    };
+
+    /*
+     * Ensure every shard is a separate listener bound to the same port.
+     */
+    TEST_F(ShardedTCPServerSocketTest, TestShardsShareThePort)
+    {
+        ASSERT_EQ(4, serverSocket.getShardCount());
+        ASSERT_NE(0, serverSocket.getPort());
+        ASSERT_EQ(InternetProtocolVersion::IPV4, serverSocket.getInternetProtocolVersion());
+
+        std::vector<SOCKET> sockets = serverSocket.getSockets();
+        ASSERT_EQ(4, std::set<SOCKET>(sockets.begin(), sockets.end()).size());
+        for (size_t i = 0; i < serverSocket.getShardCount(); i++)
+        {
+            ASSERT_FALSE(isInvalidSocket(sockets.at(i)));
+            ASSERT_EQ(serverSocket.getPort(), serverSocket.getShard(i).getPort());
+        }
+        ASSERT_THROW(serverSocket.getShard(4), std::out_of_range);
+    }
+
+    /*
+     * Ensure connections to the shared port are each queued on exactly one of the shards.
+     */
+    TEST_F(ShardedTCPServerSocketTest, TestConnectionsSpreadAcrossShards)
+    {
+        const size_t connectionCount = 32;
+        std::vector<TCPSocket> clients;
+        for (size_t i = 0; i < connectionCount; i++)
+        {
+            clients.emplace_back("127.0.0.1", serverSocket.getPort(), InternetProtocolVersion::IPV4);
+        }
+
+        std::vector<TCPSocket> accepted;
+        for (size_t shard = 0; shard < serverSocket.getShardCount(); shard++)
+        {
+            pollfd descriptor{ serverSocket.getShard(shard).getSocket(), POLLIN, 0 };
+            while (::poll(&descriptor, 1, 0) > 0)
+            {
+                accepted.push_back(serverSocket.accept(shard));
+            }
+        }
+        ASSERT_EQ(connectionCount, accepted.size());
+
+        for (TCPSocket& socket : accepted)
+        {
+            socket.close();
+        }
+        for (TCPSocket& client : clients)
+        {
+            client.close();
+        }
+    }
+
+    /*
+     * Ensure the provided pre bind operation is run for every shard and that a listener without SO_REUSEPORT cannot join.
+     */
+    TEST_F(ShardedTCPServerSocketTest, TestPreBindOperationAndExclusivePort)
+    {
+        unsigned int invocations = 0;
+        ShardedTCPServerSocket other(3, std::nullopt, 0, 20, InternetProtocolVersion::IPV4, [&invocations](SOCKET&) { invocations++; });
+        ASSERT_EQ(3, invocations);
+        other.close();
+
+        ASSERT_THROW({
+            TCPServerSocket exclusive(std::nullopt, serverSocket.getPort(), 20, InternetProtocolVersion::IPV4);
+        }, BindingException);
+        ASSERT_THROW({
+            ShardedTCPServerSocket empty(0);
+        }, SocketException);
+    }
+
+    /*
+     * Ensure accepting from a shard without any queued connections times out.
+     */
+    TEST_F(ShardedTCPServerSocketTest, TestAcceptTimeout)
+    {
+        ASSERT_THROW(serverSocket.accept(1, 1000), TimeoutException);
+    }
+#endif
+}
@@ -1,5 +1,6 @@
 
 #include <chrono>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -7,6 +8,12 @@
 #include "../../src/socketexceptions/BindingException.hpp"
 #include "../../src/socketexceptions/TimeoutException.hpp"
 
+#ifndef _WIN32
+
+#include <fcntl.h>
+
+#endif
+
 namespace kt
 {
     class TCPServerSocketTest: public ::testing::Test
@@ -133,4 +140,118 @@ namespace kt
         std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
         ASSERT_GE(seconds, std::chrono::duration_cast<std::chrono::seconds>(end - start).count());
     }
+
+    /*
+     * Ensure the hostname of an accepted socket is formatted from its remote address when requested.
+     */
+    TEST_F(TCPServerSocketTest, TestAcceptedSocketHostname)
+    {
+        serverSocket.close();
+        TCPServerSocket ipv4Server(std::nullopt, 0, 20, InternetProtocolVersion::IPV4);
+
+        TCPSocket client("127.0.0.1", ipv4Server.getPort());
+        TCPSocket accepted = ipv4Server.accept(1000000);
+        ASSERT_EQ("127.0.0.1", accepted.getHostname());
+        ASSERT_EQ(client.getSocketAddress().ipv4.sin_addr.s_addr, accepted.getSocketAddress().ipv4.sin_addr.s_addr);
+
+        TCPSocket copied = accepted;
+        ASSERT_EQ("127.0.0.1", copied.getHostname());
+
+        client.close();
+        accepted.close();
+        ipv4Server.close();
+    }
+
+    /*
+     * Ensure acceptMany() drains the queued connections up to the maximum and leaves the listener in blocking mode.
+     */
+    TEST_F(TCPServerSocketTest, TestAcceptMany)
+    {
+        serverSocket.close();
+        TCPServerSocket ipv4Server(std::nullopt, 0, 20, InternetProtocolVersion::IPV4);
+        std::vector<TCPSocket> clients;
+        for (int i = 0; i < 5; i++)
+        {
+            clients.emplace_back("127.0.0.1", ipv4Server.getPort());
+        }
+
+        std::vector<TCPSocket> first = ipv4Server.acceptMany(3, 1000000);
+        ASSERT_EQ(3, first.size());
+        ASSERT_FALSE(first.front().isNonBlocking());
+        std::vector<TCPSocket> second = ipv4Server.acceptMany(10, 1000000, true);
+        ASSERT_EQ(2, second.size());
+        ASSERT_TRUE(second.front().isNonBlocking());
+        ASSERT_EQ("127.0.0.1", second.front().getHostname());
+#ifndef _WIN32
+        ASSERT_EQ(0, fcntl(ipv4Server.getSocket(), F_GETFL) & O_NONBLOCK);
+#endif
+
+        ASSERT_THROW(ipv4Server.acceptMany(10, 10000), TimeoutException);
+
+        // A blocking wait returns as soon as the first connection is accepted
+        clients.emplace_back("127.0.0.1", ipv4Server.getPort());
+        ASSERT_EQ(1, ipv4Server.acceptMany(10).size());
+
+        for (std::vector<TCPSocket>* sockets : { &clients, &first, &second })
+        {
+            for (TCPSocket& socket : *sockets)
+            {
+                socket.close();
+            }
+        }
+        ipv4Server.close();
+    }
+
+#ifndef _WIN32
+    /*
+     * Ensure acceptMany() drains a non-blocking listener until its queue is empty and leaves it in non-blocking mode.
+     */
+    TEST_F(TCPServerSocketTest, TestAcceptManyNonBlockingListener)
+    {
+        serverSocket.close();
+        TCPServerSocket ipv4Server(std::nullopt, 0, 20, InternetProtocolVersion::IPV4);
+        ASSERT_EQ(0, fcntl(ipv4Server.getSocket(), F_SETFL, fcntl(ipv4Server.getSocket(), F_GETFL) | O_NONBLOCK));
+        ASSERT_TRUE(ipv4Server.acceptMany(10).empty());
+
+        std::vector<TCPSocket> clients;
+        for (int i = 0; i < 3; i++)
+        {
+            clients.emplace_back("127.0.0.1", ipv4Server.getPort());
+        }
+
+        std::vector<TCPSocket> accepted = ipv4Server.acceptMany(10, 1000000);
+        ASSERT_EQ(3, accepted.size());
+        ASSERT_NE(0, fcntl(ipv4Server.getSocket(), F_GETFL) & O_NONBLOCK);
+
+        for (std::vector<TCPSocket>* sockets : { &clients, &accepted })
+        {
+            for (TCPSocket& socket : *sockets)
+            {
+                socket.close();
+            }
+        }
+        ipv4Server.close();
+    }
+#endif
+
+    /*
+     * Ensure tryAccept() reports a timeout and a closed listener through its result instead of throwing.
+     */
+    TEST_F(TCPServerSocketTest, TestTryAccept)
+    {
+        Result<TCPSocket> result = serverSocket.tryAccept(10000);
+        ASSERT_FALSE(result);
+        ASSERT_EQ(ResultError::Timeout, result.getError());
+
+        TCPSocket client(kt::getLocalAddress(serverSocket.getInternetProtocolVersion()), serverSocket.getPort());
+        result = serverSocket.tryAccept(1000000, true);
+        ASSERT_TRUE(result);
+        ASSERT_TRUE(result.value().isNonBlocking());
+        ASSERT_EQ(serverSocket.getPort(), kt::getPortNumber(client.getSocketAddress()));
+
+        result.value().close();
+        client.close();
+        serverSocket.close();
+        ASSERT_EQ(ResultError::InvalidSocket, serverSocket.tryAccept().getError());
+    }
 }
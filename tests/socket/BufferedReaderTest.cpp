@@ -0,0 +1,117 @@
+#include <string>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+#include "../../src/socket/BufferedReader.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+
+const std::string LOCALHOST = "localhost";
+
+namespace kt
+{
+    class BufferedReaderTest : public ::testing::Test
+    {
+    protected:
+        TCPServerSocket serverSocket;
+        TCPSocket socket;
+        TCPSocket server;
+
+    protected:
+        BufferedReaderTest() : serverSocket(), socket(LOCALHOST, serverSocket.getPort()), server(serverSocket.accept()) { }
+        void TearDown() override
+        {
+            server.close();
+            socket.close();
+            serverSocket.close();
+        }
+    };
+
+    /*
+     * Ensure that multiple delimited messages received in a single read are each returned by readUntil().
+     */
+    TEST_F(BufferedReaderTest, BufferedReaderReadUntil)
+    {
+        BufferedReader reader(server);
+        const std::string message = "first~second~third";
+        ASSERT_EQ(socket.send(message), message.size());
+
+        ASSERT_EQ(std::make_optional<std::string>("first"), reader.readUntil('~'));
+        ASSERT_EQ(std::make_optional<std::string>("second"), reader.readUntil('~'));
+
+        // "third" has no delimiter yet, so it should be kept for the next call
+        ASSERT_EQ(std::nullopt, reader.readUntil('~'));
+        ASSERT_EQ(5, reader.available());
+
+        ASSERT_EQ(socket.send(std::string("~")), 1);
+        ASSERT_EQ(std::make_optional<std::string>("third"), reader.readUntil('~'));
+        ASSERT_EQ(0, reader.available());
+    }
+
+    /*
+     * Ensure readLine() strips both "\n" and "\r\n" line endings.
+     */
+    TEST_F(BufferedReaderTest, BufferedReaderReadLine)
+    {
+        BufferedReader reader(server);
+        const std::string message = "GET / HTTP/1.1\r\nHost: localhost\n\r\n";
+        ASSERT_EQ(socket.send(message), message.size());
+
+        ASSERT_EQ(std::make_optional<std::string>("GET / HTTP/1.1"), reader.readLine());
+        ASSERT_EQ(std::make_optional<std::string>("Host: localhost"), reader.readLine());
+        ASSERT_EQ(std::make_optional<std::string>(""), reader.readLine());
+    }
+
+    /*
+     * Ensure a line longer than the initial buffer capacity is still returned in full.
+     */
+    TEST_F(BufferedReaderTest, BufferedReaderLineLargerThanCapacity)
+    {
+        BufferedReader reader(server, 16);
+        const std::string line(1000, 'a');
+        ASSERT_EQ(socket.send(line + "\nnext\n"), line.size() + 6);
+
+        ASSERT_EQ(std::make_optional(line), reader.readLine(100000));
+        ASSERT_EQ(std::make_optional<std::string>("next"), reader.readLine());
+    }
+
+    /*
+     * Ensure readExact() only returns once all the requested characters have arrived, keeping any partial data.
+     */
+    TEST_F(BufferedReaderTest, BufferedReaderReadExact)
+    {
+        BufferedReader reader(server);
+        ASSERT_EQ(socket.send(std::string("abc")), 3);
+        ASSERT_EQ(std::nullopt, reader.readExact(5));
+        ASSERT_EQ(3, reader.available());
+
+        ASSERT_EQ(socket.send(std::string("defgh")), 5);
+        ASSERT_EQ(std::make_optional<std::string>("abcde"), reader.readExact(5));
+
+        char buffer[3];
+        ASSERT_TRUE(reader.readExact(buffer, 3));
+        ASSERT_EQ("fgh", std::string(buffer, 3));
+        ASSERT_FALSE(reader.ready());
+    }
+
+    /*
+     * Ensure read() drains buffered characters before reading from the socket and that EOF is reported once drained.
+     */
+    TEST_F(BufferedReaderTest, BufferedReaderReadAndEOF)
+    {
+        BufferedReader reader(server);
+        ASSERT_EQ(socket.send(std::string("line\nrest")), 9);
+        ASSERT_EQ(std::make_optional<std::string>("line"), reader.readLine());
+        socket.close();
+
+        ASSERT_EQ(std::nullopt, reader.readLine());
+        ASSERT_FALSE(reader.isEOF());
+
+        char buffer[16];
+        ASSERT_EQ(4, reader.read(buffer, sizeof(buffer)));
+        ASSERT_EQ("rest", std::string(buffer, 4));
+        ASSERT_TRUE(reader.isEOF());
+        ASSERT_EQ(0, reader.read(buffer, sizeof(buffer)));
+    }
+}
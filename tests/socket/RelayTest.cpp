@@ -0,0 +1,149 @@
+#include <chrono>
+#include <future>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../../src/socket/Relay.h"
+#include "../../src/socket/TCPSocket.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+#include "../../src/ipc/IPCServerSocket.h"
+#include "../../src/ipc/StreamIPCSocket.h"
+
+#ifdef _WIN32
+    #define KT_SHUT_WR SD_SEND
+#else
+    #define KT_SHUT_WR SHUT_WR
+#endif
+
+namespace kt
+{
+    class RelayTest : public ::testing::Test
+    {
+    protected:
+        // client <-> accepted ==relay== upstream <-> backend
+        TCPServerSocket serverSocket;
+        TCPSocket client;
+        TCPSocket accepted;
+
+    protected:
+        RelayTest() : serverSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4), client("127.0.0.1", serverSocket.getPort()), accepted(serverSocket.accept()) { }
+        void TearDown() override
+        {
+            accepted.close();
+            client.close();
+            serverSocket.close();
+        }
+    };
+
+    /*
+     * Ensure data flows both ways and a half-close is passed on while the other direction keeps flowing.
+     */
+    TEST_F(RelayTest, TestRelayHalfClose)
+    {
+        TCPServerSocket backendServer(std::nullopt, 0, 20, InternetProtocolVersion::IPV4);
+        TCPSocket upstream("127.0.0.1", backendServer.getPort());
+        TCPSocket backend = backendServer.accept();
+
+        RelayCounters counters;
+        std::future<IOStatus> result = std::async(std::launch::async, [this, &upstream, &counters]()
+        {
+            return relay(accepted, upstream, counters);
+        });
+
+        const std::string request = "request";
+        ASSERT_EQ(request.size(), client.send(request));
+        ASSERT_EQ(request, backend.receiveAmount(request.size()));
+
+        // The client is done sending, the backend sees EOF but can still reply
+        ASSERT_EQ(0, ::shutdown(client.getSocket(), KT_SHUT_WR));
+        char buffer[1];
+        ASSERT_EQ(0, backend.receivePartial(buffer, 1).first);
+
+        const std::string response(256 * 1024, 'r');
+        ASSERT_EQ(IOStatus::Complete, backend.sendPartial(response.c_str(), response.size()).second);
+        backend.close();
+
+        std::string received(response.size(), '\0');
+        ASSERT_EQ(response.size(), client.receivePartial(&received[0], received.size()).first);
+        ASSERT_EQ(response, received);
+        ASSERT_EQ(IOStatus::Closed, client.receivePartial(buffer, 1).second);
+
+        ASSERT_EQ(IOStatus::Complete, result.get());
+        ASSERT_EQ(request.size(), counters.aToB);
+        ASSERT_EQ(response.size(), counters.bToA);
+        ASSERT_FALSE(accepted.isNonBlocking());
+
+        upstream.close();
+        backendServer.close();
+    }
+
+    /*
+     * Ensure a reset of a side that has already half-closed ends the relay while the other side stays idle.
+     */
+    TEST_F(RelayTest, TestRelayResetAfterHalfClose)
+    {
+        TCPServerSocket backendServer(std::nullopt, 0, 20, InternetProtocolVersion::IPV4);
+        TCPSocket upstream("127.0.0.1", backendServer.getPort());
+        TCPSocket backend = backendServer.accept();
+
+        std::future<IOStatus> result = std::async(std::launch::async, [this, &upstream]()
+        {
+            return relay(accepted, upstream);
+        });
+
+        // The backend sees EOF once the half-close has been passed on, after that the relay has nothing to do on either side
+        ASSERT_EQ(0, ::shutdown(client.getSocket(), KT_SHUT_WR));
+        char buffer[1];
+        ASSERT_EQ(0, backend.receivePartial(buffer, 1).first);
+
+        // Closing with a zero linger time resets the connection
+        linger reset{};
+        reset.l_onoff = 1;
+        reset.l_linger = 0;
+        ASSERT_EQ(0, ::setsockopt(client.getSocket(), SOL_SOCKET, SO_LINGER, reinterpret_cast<const char*>(&reset), sizeof(reset)));
+        client.close();
+
+        const bool returned = result.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+        if (!returned)
+        {
+            // Let the relay finish so the test does not hang
+            backend.close();
+        }
+        ASSERT_TRUE(returned);
+        ASSERT_EQ(IOStatus::Closed, result.get());
+
+        backend.close();
+        upstream.close();
+        backendServer.close();
+    }
+
+    /*
+     * Ensure a TCP connection can be relayed to a unix domain socket.
+     */
+    TEST_F(RelayTest, TestRelayToIPC)
+    {
+        const std::string path = "/tmp/RelayTest.sock";
+        IPCServerSocket backendServer(path);
+        StreamIPCSocket upstream(path);
+        StreamIPCSocket backend = backendServer.accept();
+
+        std::future<IOStatus> result = std::async(std::launch::async, [this, &upstream]()
+        {
+            return relay(accepted, upstream);
+        });
+
+        const std::string request = "over ipc";
+        ASSERT_EQ(request.size(), client.send(request));
+        ASSERT_EQ(request, backend.receiveAmount(request.size()));
+        ASSERT_EQ(request.size(), backend.send(request));
+        ASSERT_EQ(request, client.receiveAmount(request.size()));
+
+        client.close();
+        backend.close();
+        ASSERT_EQ(IOStatus::Complete, result.get());
+
+        upstream.close();
+        backendServer.close();
+    }
+}
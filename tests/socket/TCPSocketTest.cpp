@@ -4,12 +4,16 @@
 #include <chrono>
 #include <thread>
 #include <csignal>
+#include <fstream>
+#include <functional>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "../../src/socket/TCPSocket.h"
 #include "../../src/serversocket/TCPServerSocket.h"
 #include "../../src/socketexceptions/BindingException.hpp"
+#include "../../src/socketexceptions/TimeoutException.hpp"
 #include "../../src/socketexceptions/SocketError.h"
 
 const std::string LOCALHOST = "localhost"; //"127.0.0.1";
@@ -29,6 +33,37 @@ namespace kt
             socket.close();
             serverSocket.close();
         }
+
+        /*
+         * Connects to a server with a backlog of 1 until its accept queue is full and a connection attempt times out, since the
+         * server no longer completes the handshake.
+         *
+         * @return *true* if *connect* threw a TimeoutException before 16 connections were queued.
+         */
+        bool connectUntilTimeout(const std::function<TCPSocket(const TCPServerSocket&)>& connect)
+        {
+            TCPServerSocket fullServer(std::nullopt, 0, 1, InternetProtocolVersion::IPV4);
+            std::vector<TCPSocket> queued;
+            bool timedOut = false;
+            for (int i = 0; i < 16 && !timedOut; i++)
+            {
+                try
+                {
+                    queued.push_back(connect(fullServer));
+                }
+                catch (const TimeoutException&)
+                {
+                    timedOut = true;
+                }
+            }
+
+            for (TCPSocket& client : queued)
+            {
+                client.close();
+            }
+            fullServer.close();
+            return timedOut;
+        }
     };
 
     /*
@@ -88,6 +123,61 @@ namespace kt
         }, SocketException);
     }
 
+    /*
+     * Ensure the racing constructor connects and leaves the socket in blocking mode.
+     */
+    TEST_F(TCPSocketTest, TCPConstructor_HappyEyeballs)
+    {
+        TCPSocket raced(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::Any, 1000000, 1000);
+        ASSERT_TRUE(raced.connected());
+        ASSERT_FALSE(raced.isNonBlocking());
+        ASSERT_EQ(serverSocket.getPort(), raced.getPort());
+        ASSERT_NE(InternetProtocolVersion::Any, raced.getInternetProtocolVersion());
+
+        // The fixture's connection is queued first
+        TCPSocket fixtureServer = serverSocket.accept();
+        TCPSocket server = serverSocket.accept();
+        const std::string testString = "raced";
+        ASSERT_EQ(raced.send(testString), testString.size());
+        ASSERT_EQ(testString, server.receiveAmount(testString.size()));
+
+        fixtureServer.close();
+        server.close();
+        raced.close();
+    }
+
+    /*
+     * Ensure the racing constructor reports refused connections as a SocketException rather than waiting for the timeout.
+     */
+    TEST_F(TCPSocketTest, TCPConstructor_HappyEyeballsRefused)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        try
+        {
+            TCPSocket failedSocket(LOCALHOST, serverSocket.getPort() + 1, InternetProtocolVersion::Any, 5000000);
+            FAIL();
+        }
+        catch (const TimeoutException&)
+        {
+            FAIL();
+        }
+        catch (const SocketException&)
+        {
+        }
+        ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    }
+
+    /*
+     * Ensure the racing constructor gives up once the deadline passes when the server does not complete the handshake.
+     */
+    TEST_F(TCPSocketTest, TCPConstructor_HappyEyeballsTimeout)
+    {
+        ASSERT_TRUE(connectUntilTimeout([](const TCPServerSocket& fullServer)
+        {
+            return TCPSocket(LOCALHOST, fullServer.getPort(), InternetProtocolVersion::IPV4, 100000);
+        }));
+    }
+
     // Ensure we can construct and connect to a server from the address it is listening on
     TEST_F(TCPSocketTest, TCPConstructor_FromAddress)
     {
@@ -112,6 +202,47 @@ namespace kt
         acceptedFromAddress.close();
     }
 
+    // Ensure we can connect to a server from its address with a timeout, and that a refused connection is not reported as a timeout
+    TEST_F(TCPSocketTest, TCPConstructor_FromAddressWithTimeout)
+    {
+        TCPSocket server = serverSocket.accept();
+
+        TCPSocket fromAddress(serverSocket.getSocketAddress(), 1000000);
+        TCPSocket acceptedFromAddress = serverSocket.accept();
+        ASSERT_FALSE(fromAddress.isNonBlocking());
+
+        std::string sentFromAddress = "sentFromAddress";
+        ASSERT_EQ(fromAddress.send(sentFromAddress), sentFromAddress.size());
+        ASSERT_EQ(sentFromAddress, acceptedFromAddress.receiveAmount(sentFromAddress.size()));
+
+        TCPServerSocket closedServer(std::nullopt, 0, 20, serverSocket.getInternetProtocolVersion());
+        kt::SocketAddress closedAddress = closedServer.getSocketAddress();
+        closedServer.close();
+        ASSERT_THROW({
+            try
+            {
+                TCPSocket refused(closedAddress, 1000000);
+            }
+            catch (const TimeoutException&)
+            {
+                FAIL();
+            }
+        }, SocketException);
+
+        server.close();
+        fromAddress.close();
+        acceptedFromAddress.close();
+    }
+
+    // Ensure a TimeoutException is thrown when the server does not complete the handshake within the timeout
+    TEST_F(TCPSocketTest, TCPConstructor_FromAddressWithTimeout_Expired)
+    {
+        ASSERT_TRUE(connectUntilTimeout([](const TCPServerSocket& fullServer)
+        {
+            return TCPSocket(fullServer.getSocketAddress(), 100000);
+        }));
+    }
+
     // Ensure we throw a SocketException if we cannot construct a TCP socket from the provided SocketAddress
     TEST_F(TCPSocketTest, TCPConstructor_FromEmptyAddress)
     {
@@ -196,6 +327,50 @@ namespace kt
         server.close();
     }
 
+    /*
+     * Ensure receiveAll() appends into the provided buffer, keeps '\0' characters and reports when the remote closes the connection.
+     */
+    TEST_F(TCPSocketTest, TCPReceiveAll_IntoBufferUntilEOF)
+    {
+        TCPSocket server = serverSocket.accept();
+        std::string payload(1024 * 1024, 'a');
+        payload[0] = '\0';
+        payload[payload.size() / 2] = '\0';
+
+        std::thread sender([&]() {
+            size_t sent = 0;
+            while (sent < payload.size())
+            {
+                int result = socket.send(payload.c_str() + sent, static_cast<int>(payload.size() - sent));
+                if (result < 1)
+                {
+                    break;
+                }
+                sent += result;
+            }
+            socket.close();
+        });
+
+        std::string buffer = "prefix";
+        std::pair<int, IOStatus> result = std::make_pair(0, IOStatus::Complete);
+        // Bounded so a receive error or a connection that never closes fails the test rather than hanging it
+        for (int i = 0; i < 100 && result.second == IOStatus::Complete; i++)
+        {
+            std::pair<int, IOStatus> next = server.receiveAll(buffer, 1000000);
+            result.first += next.first;
+            result.second = next.second;
+        }
+        sender.join();
+
+        ASSERT_EQ(IOStatus::Closed, result.second);
+        ASSERT_EQ(payload.size(), result.first);
+        ASSERT_EQ("prefix" + payload, buffer);
+
+        // A dead socket is reported as an error rather than as an idle connection
+        server.close();
+        ASSERT_EQ(IOStatus::Error, server.receiveAll(buffer).second);
+    }
+
     TEST_F(TCPSocketTest, TCPReceiveToDelimiter)
     {
         TCPSocket server = serverSocket.accept();
@@ -251,6 +426,68 @@ namespace kt
         server.close();
     }
 
+    /*
+     * Ensure that in non-blocking mode receivePartial() returns the data available and reports WouldBlock instead of waiting,
+     * and reports Closed once the remote closes the connection.
+     */
+    TEST_F(TCPSocketTest, TCPNonBlockingReceivePartial)
+    {
+        TCPSocket server = serverSocket.accept(0, true);
+        ASSERT_TRUE(server.isNonBlocking());
+        ASSERT_FALSE(socket.isNonBlocking());
+
+        char buffer[16];
+        std::pair<int, IOStatus> result = server.receivePartial(buffer, sizeof(buffer));
+        ASSERT_EQ(0, result.first);
+        ASSERT_EQ(IOStatus::WouldBlock, result.second);
+
+        const std::string testString = "test";
+        ASSERT_EQ(socket.send(testString), testString.size());
+        ASSERT_TRUE(server.ready());
+        result = server.receivePartial(buffer, sizeof(buffer));
+        ASSERT_EQ(testString.size(), result.first);
+        ASSERT_EQ(IOStatus::WouldBlock, result.second);
+        ASSERT_EQ(testString, std::string(buffer, result.first));
+
+        ASSERT_EQ(socket.send(testString), testString.size());
+        ASSERT_TRUE(server.ready());
+        result = server.receivePartial(buffer, 2);
+        ASSERT_EQ(2, result.first);
+        ASSERT_EQ(IOStatus::Complete, result.second);
+
+        socket.close();
+        ASSERT_TRUE(server.ready());
+        result = server.receivePartial(buffer, sizeof(buffer));
+        ASSERT_EQ(2, result.first);
+        ASSERT_EQ(IOStatus::Closed, result.second);
+
+        server.close();
+    }
+
+    /*
+     * Ensure that in non-blocking mode sendPartial() stops with WouldBlock once the send buffers are full.
+     */
+    TEST_F(TCPSocketTest, TCPNonBlockingSendPartial)
+    {
+        TCPSocket server = serverSocket.accept();
+        ASSERT_TRUE(socket.setNonBlocking(true));
+        ASSERT_TRUE(socket.isNonBlocking());
+
+        const std::string chunk(64 * 1024, 'a');
+        std::pair<int, IOStatus> result = std::make_pair(0, IOStatus::Complete);
+        for (int i = 0; i < 1024 && result.second == IOStatus::Complete; i++)
+        {
+            result = socket.sendPartial(chunk.c_str(), static_cast<int>(chunk.size()));
+        }
+        ASSERT_EQ(IOStatus::WouldBlock, result.second);
+        ASSERT_LT(result.first, chunk.size());
+
+        ASSERT_TRUE(socket.setNonBlocking(false));
+        ASSERT_FALSE(socket.isNonBlocking());
+
+        server.close();
+    }
+
 #ifdef __linux__
     bool sigPipeHandlerWasCalled = false;
     void handleSignal(int signal)
@@ -394,4 +631,138 @@ namespace kt
 
         server.close();
     }
+
+    /*
+     * Ensure the exception-free connect, send and receive report success and failures through their result.
+     */
+    TEST_F(TCPSocketTest, TCPTryConnect)
+    {
+        Result<TCPSocket> connected = TCPSocket::tryConnect(LOCALHOST, serverSocket.getPort(), InternetProtocolVersion::Any, 1000000);
+        ASSERT_TRUE(connected.isSuccess());
+        ASSERT_EQ(ResultError::None, connected.getError());
+        TCPSocket client = connected.value();
+        // The fixture's connection is queued ahead of this one
+        serverSocket.accept().close();
+        TCPSocket server = serverSocket.accept();
+
+        const std::string testString = "try";
+        Result<int> sent = client.trySend(testString.c_str(), testString.size());
+        ASSERT_TRUE(sent);
+        ASSERT_EQ(testString.size(), sent.value());
+
+        char buffer[8];
+        Result<int> received = server.tryReceiveAmount(buffer, testString.size());
+        ASSERT_TRUE(received);
+        ASSERT_EQ(testString, std::string(buffer, received.value()));
+
+        client.close();
+        received = server.tryReceiveAmount(buffer, 1);
+        ASSERT_EQ(ResultError::Closed, received.getError());
+        server.close();
+        ASSERT_EQ(ResultError::InvalidSocket, server.trySend(testString.c_str(), testString.size()).getError());
+
+        const unsigned short port = serverSocket.getPort();
+        serverSocket.close();
+        Result<TCPSocket> refused = TCPSocket::tryConnect(LOCALHOST, port);
+        ASSERT_FALSE(refused);
+        ASSERT_EQ(ResultError::System, refused.getError());
+        ASSERT_NE(0, refused.getCode());
+        ASSERT_FALSE(refused.getErrorMessage().empty());
+        ASSERT_THROW(refused.value(), std::bad_optional_access);
+    }
+
+    /*
+     * Ensure a non-blocking sendFile() stops when the socket is full and can be resumed from the returned offset.
+     */
+    TEST_F(TCPSocketTest, TCPSendFile_NonBlockingResume)
+    {
+        const std::string path = "/tmp/TCPSocketTestSendFile.bin";
+        std::string content(16 * 1024 * 1024, '\0');
+        for (size_t i = 0; i < content.size(); i++)
+        {
+            content[i] = static_cast<char>(i % 251);
+        }
+        std::ofstream(path, std::ios::binary).write(content.data(), content.size());
+
+        TCPSocket server = serverSocket.accept();
+        const int64_t offset = 100;
+        ASSERT_TRUE(socket.setNonBlocking(true));
+        std::pair<size_t, IOStatus> result = socket.sendFile(path, offset);
+        ASSERT_EQ(IOStatus::WouldBlock, result.second);
+        size_t sent = result.first;
+        ASSERT_LT(sent, content.size() - offset);
+
+        std::string received(content.size() - offset, '\0');
+        std::thread reader([&server, &received]()
+        {
+            server.receivePartial(&received[0], received.size());
+        });
+        while (sent < content.size() - offset)
+        {
+            result = socket.sendFile(path, offset + sent);
+            sent += result.first;
+            if (result.second == IOStatus::WouldBlock)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            else
+            {
+                ASSERT_EQ(IOStatus::Complete, result.second);
+            }
+        }
+        reader.join();
+        ASSERT_EQ(content.substr(offset), received);
+
+        server.close();
+        std::remove(path.c_str());
+    }
+
+    /*
+     * Ensure sendv() sends every buffer in order as a single stream, skipping empty buffers.
+     */
+    TEST_F(TCPSocketTest, TCPSendv)
+    {
+        TCPSocket server = serverSocket.accept();
+        const std::string header = "Content-Length: 4\r\n\r\n";
+        const std::string body = "body";
+        const std::vector<std::string_view> buffers = { header, std::string_view(), body };
+
+        std::pair<size_t, IOStatus> result = socket.sendv(buffers);
+        ASSERT_EQ(header.size() + body.size(), result.first);
+        ASSERT_EQ(IOStatus::Complete, result.second);
+        ASSERT_EQ(header + body, server.receiveAmount(header.size() + body.size()));
+
+        ASSERT_EQ(IOStatus::Complete, socket.sendv(std::vector<std::string_view>()).second);
+        server.close();
+    }
+
+    /*
+     * Ensure sendAll() sends everything once the receiver keeps up, and stops at the deadline when it does not.
+     */
+    TEST_F(TCPSocketTest, TCPSendAll_Timeout)
+    {
+        TCPSocket server = serverSocket.accept();
+        const std::string message(32 * 1024 * 1024, 'a');
+
+        // Nothing is reading, so the send buffers fill and the deadline passes
+        std::pair<size_t, IOStatus> result = socket.sendAll(message, 100000);
+        ASSERT_EQ(IOStatus::Timeout, result.second);
+        ASSERT_GT(result.first, 0);
+        ASSERT_LT(result.first, message.size());
+        ASSERT_FALSE(socket.isNonBlocking());
+
+        const size_t remaining = message.size() - result.first;
+        std::string received(message.size(), '\0');
+        std::thread reader([&server, &received]()
+        {
+            server.receivePartial(&received[0], received.size());
+        });
+        result = socket.sendAll(message.c_str() + (message.size() - remaining), remaining);
+        reader.join();
+        ASSERT_EQ(remaining, result.first);
+        ASSERT_EQ(IOStatus::Complete, result.second);
+        ASSERT_EQ(message, received);
+
+        server.close();
+    }
 }
@@ -83,6 +83,24 @@ namespace kt
         ASSERT_NE(0, socket.getListeningPort());
     }
 
+    /*
+     * Ensure tryBind() returns the bound address, and the error code when the port is already in use.
+     */
+    TEST_F(UDPSocketTest, UDPTryBind)
+    {
+        Result<SocketAddress> bound = socket.tryBind(kt::InternetProtocolVersion::IPV4);
+        ASSERT_TRUE(bound);
+        ASSERT_TRUE(socket.isBound());
+        ASSERT_EQ(socket.getListeningPort().value(), kt::getPortNumber(bound.value()));
+
+        UDPSocket other;
+        Result<SocketAddress> inUse = other.tryBind(kt::InternetProtocolVersion::IPV4, std::nullopt, socket.getListeningPort().value());
+        ASSERT_FALSE(inUse);
+        ASSERT_EQ(ResultError::System, inUse.getError());
+        ASSERT_NE(0, inUse.getCode());
+        ASSERT_FALSE(other.isBound());
+    }
+
     /*
      * Test UDPSocket.sendTo() to ensure that it can send correctly to the listening socket.
      */
@@ -455,4 +473,151 @@ namespace kt
             GTEST_SKIP();
         }
     }
+
+    /*
+     * Ensure that with send socket caching enabled multiple sends reuse the same socket, so the pre-send operation is only run once.
+     */
+    TEST_F(UDPSocketTest, UDPSendTo_CachedSendSocket)
+    {
+        std::pair<int, kt::SocketAddress> bindResult = socket.bind(kt::InternetProtocolVersion::IPV4);
+        ASSERT_EQ(0, bindResult.first);
+
+        UDPSocket client;
+        int createdSockets = 0;
+        client.setPreSendSocketOperation([&createdSockets](SOCKET&) { createdSockets++; });
+        ASSERT_FALSE(client.isSendSocketCachingEnabled());
+        client.setSendSocketCaching(true);
+        ASSERT_TRUE(client.isSendSocketCachingEnabled());
+
+        const std::string message = "cached";
+        for (int i = 0; i < 3; i++)
+        {
+            ASSERT_EQ(message.size(), client.sendTo(bindResult.second, message));
+            while(!socket.ready()) {}
+            ASSERT_EQ(message, socket.receiveFrom(message.size()).first.value());
+        }
+        ASSERT_EQ(1, createdSockets);
+
+        // Closing the socket closes the cached socket, a new one is created on the next send
+        client.close();
+        ASSERT_EQ(message.size(), client.sendTo(bindResult.second, message));
+        ASSERT_EQ(2, createdSockets);
+
+        client.close();
+    }
+
+    /*
+     * Ensure a connected UDPSocket can send to its fixed peer with send() and that disconnect() stops this.
+     */
+    TEST_F(UDPSocketTest, UDPConnectAndSend)
+    {
+        std::pair<int, kt::SocketAddress> bindResult = socket.bind(kt::InternetProtocolVersion::IPV4);
+        ASSERT_EQ(0, bindResult.first);
+
+        UDPSocket client;
+        const std::string message = "connected";
+        ASSERT_FALSE(client.isConnected());
+        ASSERT_EQ(-1, client.send(message));
+        const unsigned int generation = client.getConnectionGeneration();
+
+        ASSERT_EQ(0, client.connect(bindResult.second));
+        ASSERT_TRUE(client.isConnected());
+        ASSERT_EQ(generation + 1, client.getConnectionGeneration());
+        ASSERT_EQ(kt::getPortNumber(bindResult.second), kt::getPortNumber(client.getConnectedAddress().value()));
+
+        ASSERT_EQ(message.size(), client.send(message));
+        while(!socket.ready()) {}
+        ASSERT_EQ(message, socket.receiveFrom(message.size()).first.value());
+
+        client.disconnect();
+        ASSERT_FALSE(client.isConnected());
+        ASSERT_EQ(std::nullopt, client.getConnectedAddress());
+        ASSERT_EQ(-1, client.send(message));
+        ASSERT_EQ(generation + 1, client.getConnectionGeneration());
+    }
+
+    /*
+     * Ensure sendBatch() delivers every message and records a per message result, including for messages that cannot be sent.
+     */
+    TEST_F(UDPSocketTest, UDPSendBatch)
+    {
+        std::pair<int, kt::SocketAddress> bindResult = socket.bind(kt::InternetProtocolVersion::IPV4);
+        ASSERT_EQ(0, bindResult.first);
+
+        std::vector<std::string> payloads = { "one", "two", "three", "four" };
+        std::vector<kt::UDPSendMessage> messages;
+        for (const std::string& payload : payloads)
+        {
+            kt::UDPSendMessage message;
+            message.address = bindResult.second;
+            message.buffer = payload.c_str();
+            message.length = static_cast<int>(payload.size());
+            messages.push_back(message);
+        }
+        // A message with no address family can not be sent
+        kt::UDPSendMessage invalidMessage;
+        invalidMessage.buffer = payloads[0].c_str();
+        invalidMessage.length = static_cast<int>(payloads[0].size());
+        messages.push_back(invalidMessage);
+
+        UDPSocket client;
+        client.setSendSocketCaching(true);
+        ASSERT_EQ(payloads.size(), client.sendBatch(messages));
+        for (size_t i = 0; i < payloads.size(); i++)
+        {
+            ASSERT_EQ(payloads[i].size(), messages[i].result);
+
+            while(!socket.ready()) {}
+            ASSERT_EQ(payloads[i], socket.receiveFrom(100).first.value());
+        }
+        ASSERT_EQ(-1, messages.back().result);
+
+        client.close();
+    }
+
+    /*
+     * Ensure receiveBatch() fills one slot per queued datagram, recording the sender and whether the datagram was truncated.
+     */
+    TEST_F(UDPSocketTest, UDPReceiveBatch)
+    {
+        std::vector<kt::UDPReceiveSlot> slots(4);
+        std::vector<std::vector<char>> buffers(slots.size(), std::vector<char>(8));
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            slots[i].buffer = buffers[i].data();
+            slots[i].capacity = static_cast<int>(buffers[i].size());
+        }
+        ASSERT_EQ(-1, socket.receiveBatch(slots));
+
+        std::pair<int, kt::SocketAddress> bindResult = socket.bind(kt::InternetProtocolVersion::IPV4);
+        ASSERT_EQ(0, bindResult.first);
+        ASSERT_EQ(0, socket.receiveBatch(slots, 1000));
+
+        UDPSocket client;
+        ASSERT_EQ(0, client.connect(bindResult.second));
+        const std::vector<std::string> payloads = { "first", "second", "too long for slot" };
+        for (const std::string& payload : payloads)
+        {
+            ASSERT_EQ(payload.size(), client.send(payload));
+        }
+
+        int received = 0;
+        while (received < static_cast<int>(payloads.size()))
+        {
+            int result = socket.receiveBatch(&slots[received], slots.size() - received, 1000000);
+            ASSERT_GT(result, 0);
+            received += result;
+        }
+        ASSERT_EQ(payloads.size(), received);
+
+        ASSERT_EQ("first", std::string(slots[0].buffer, slots[0].length));
+        ASSERT_FALSE(slots[0].truncated);
+        ASSERT_EQ("second", std::string(slots[1].buffer, slots[1].length));
+        ASSERT_EQ("too long", std::string(slots[2].buffer, slots[2].length));
+        ASSERT_TRUE(slots[2].truncated);
+        ASSERT_EQ(kt::InternetProtocolVersion::IPV4, kt::getInternetProtocolVersion(slots[0].address));
+        ASSERT_NE(0, kt::getPortNumber(slots[0].address));
+
+        client.close();
+    }
 }
@@ -0,0 +1,145 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../../src/socket/ZeroCopySender.h"
+#include "../../src/serversocket/TCPServerSocket.h"
+
+namespace kt
+{
+    class ZeroCopySenderTest : public ::testing::Test
+    {
+    protected:
+        TCPServerSocket serverSocket;
+        TCPSocket socket;
+        TCPSocket server;
+
+    protected:
+        ZeroCopySenderTest() : serverSocket(std::nullopt, 0, 20, InternetProtocolVersion::IPV4), socket("127.0.0.1", serverSocket.getPort()), server(serverSocket.accept()) { }
+        void TearDown() override
+        {
+            server.close();
+            socket.close();
+            serverSocket.close();
+        }
+    };
+
+    /*
+     * Ensure sends below the threshold are copied and report their buffer reusable straight away.
+     */
+    TEST_F(ZeroCopySenderTest, TestSendBelowThreshold)
+    {
+        ZeroCopySender sender(socket, 1024);
+        const std::string message = "small";
+        bool reusable = false;
+        ASSERT_EQ(message.size(), sender.send(message.c_str(), message.size(), [&reusable]() { reusable = true; }));
+        ASSERT_TRUE(reusable);
+        ASSERT_EQ(0, sender.getPendingCount());
+        ASSERT_EQ(message, server.receiveAmount(message.size()));
+    }
+
+    /*
+     * Ensure a large send is only reported reusable once the kernel's completion has been read.
+     */
+    TEST_F(ZeroCopySenderTest, TestSendAboveThreshold)
+    {
+        ZeroCopySender sender(socket);
+        const std::string message(ZeroCopySender::DEFAULT_THRESHOLD * 4, 'z');
+        int reusable = 0;
+        ASSERT_EQ(message.size(), sender.send(message.c_str(), message.size(), [&reusable]() { reusable++; }));
+        ASSERT_EQ(message, server.receiveAmount(message.size()));
+
+        if (sender.isZeroCopyEnabled())
+        {
+            ASSERT_EQ(1, sender.getPendingCount());
+            ASSERT_EQ(0, reusable);
+            while (sender.getPendingCount() > 0)
+            {
+                ASSERT_GT(sender.processCompletions(1000000), 0);
+            }
+            // Loopback always delivers a copy
+            ASSERT_EQ(1, sender.getCopiedCount());
+        }
+        ASSERT_EQ(1, reusable);
+        ASSERT_EQ(0, sender.processCompletions());
+    }
+
+    /*
+     * Ensure a connected UDP socket can send datagrams through the sender.
+     */
+    TEST_F(ZeroCopySenderTest, TestUDPSend)
+    {
+        UDPSocket receiver;
+        std::pair<int, SocketAddress> bindResult = receiver.bind(InternetProtocolVersion::IPV4);
+        ASSERT_EQ(0, bindResult.first);
+
+        UDPSocket client;
+        ASSERT_EQ(0, client.connect(bindResult.second));
+        ZeroCopySender sender(client, 1024);
+        const std::string message(4096, 'u');
+        bool reusable = false;
+        ASSERT_EQ(message.size(), sender.send(message.c_str(), message.size(), [&reusable]() { reusable = true; }));
+        while (sender.getPendingCount() > 0)
+        {
+            ASSERT_GT(sender.processCompletions(1000000), 0);
+        }
+        ASSERT_TRUE(reusable);
+        ASSERT_EQ(message, receiver.receiveFrom(message.size()).first.value());
+
+        client.close();
+        receiver.close();
+    }
+
+    /*
+     * Ensure an empty send is copied even with a zero threshold, so it does not use up an id and later callbacks stay matched to
+     * their own sends.
+     */
+    TEST_F(ZeroCopySenderTest, TestEmptySendWithZeroThreshold)
+    {
+        ZeroCopySender sender(socket, 0);
+        bool emptyReusable = false;
+        ASSERT_EQ(0, sender.send("", 0, [&emptyReusable]() { emptyReusable = true; }));
+        ASSERT_TRUE(emptyReusable);
+        ASSERT_EQ(0, sender.getPendingCount());
+
+        const std::string message(64 * 1024, 'e');
+        int reusable = 0;
+        for (int i = 0; i < 2; i++)
+        {
+            ASSERT_EQ(message.size(), sender.send(message.c_str(), message.size(), [&reusable]() { reusable++; }));
+            ASSERT_EQ(message, server.receiveAmount(message.size()));
+        }
+        while (sender.getPendingCount() > 0)
+        {
+            ASSERT_GT(sender.processCompletions(1000000), 0);
+        }
+        ASSERT_EQ(2, reusable);
+    }
+
+    /*
+     * Ensure a UDP socket that was reconnected after the sender was created falls back to copying, since its new descriptor was
+     * never enabled for zero-copy.
+     */
+    TEST_F(ZeroCopySenderTest, TestUDPReconnectFallsBackToCopy)
+    {
+        UDPSocket receiver;
+        std::pair<int, SocketAddress> bindResult = receiver.bind(InternetProtocolVersion::IPV4);
+        ASSERT_EQ(0, bindResult.first);
+
+        UDPSocket client;
+        ASSERT_EQ(0, client.connect(bindResult.second));
+        ZeroCopySender sender(client, 1024);
+        client.disconnect();
+        ASSERT_EQ(0, client.connect(bindResult.second));
+
+        const std::string message(4096, 'r');
+        bool reusable = false;
+        ASSERT_EQ(message.size(), sender.send(message.c_str(), message.size(), [&reusable]() { reusable = true; }));
+        ASSERT_TRUE(reusable);
+        ASSERT_EQ(0, sender.getPendingCount());
+        ASSERT_EQ(message, receiver.receiveFrom(message.size()).first.value());
+
+        client.close();
+        receiver.close();
+    }
+}